@@ -10,11 +10,19 @@
 #ifndef HIPONY_ENUMERATE_HPP_INCLUDED
 #define HIPONY_ENUMERATE_HPP_INCLUDED
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cwchar>
+#include <iosfwd>
 #include <iterator>
+#include <limits>
 #include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #ifndef HIPONY_ENUMERATE_NAMESPACE
 #define HIPONY_ENUMERATE_NAMESPACE hipony
@@ -122,6 +130,97 @@
 #define HIPONY_ENUMERATE_HAS_AGGREGATES 0
 #endif
 
+#if HIPONY_ENUMERATE_PARALLEL_ENABLED
+#define HIPONY_ENUMERATE_HAS_PARALLEL 1
+#else
+#define HIPONY_ENUMERATE_HAS_PARALLEL 0
+#endif
+
+#if defined(__cpp_lib_string_view)
+#define HIPONY_ENUMERATE_HAS_STRING_VIEW (__cpp_lib_string_view >= 201606L)
+#else
+#define HIPONY_ENUMERATE_HAS_STRING_VIEW false
+#endif
+
+#if HIPONY_ENUMERATE_HAS_STRING_VIEW
+#include <string_view>
+#endif
+
+// NOTE: Only the CSV scanner uses the intrinsics, and it requires std::string_view
+#if HIPONY_ENUMERATE_HAS_STRING_VIEW \
+    && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define HIPONY_ENUMERATE_HAS_SSE2 1
+#else
+#define HIPONY_ENUMERATE_HAS_SSE2 0
+#endif
+
+#if defined(__cpp_lib_byte)
+#define HIPONY_ENUMERATE_HAS_BYTE (__cpp_lib_byte >= 201603L)
+#else
+#define HIPONY_ENUMERATE_HAS_BYTE false
+#endif
+
+#if HIPONY_ENUMERATE_FILES_ENABLED
+#if !HIPONY_ENUMERATE_HAS_STRING_VIEW
+#error Full C++17 support is required to use the Files feature
+#endif
+#if !defined(__unix__) && !defined(__APPLE__)
+#error The Files feature requires a POSIX system
+#endif
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#define HIPONY_ENUMERATE_HAS_FILES 1
+#else
+#define HIPONY_ENUMERATE_HAS_FILES 0
+#endif
+
+#if HIPONY_ENUMERATE_HAS_FILES && defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define HIPONY_ENUMERATE_HAS_IO_URING 1
+#endif
+#endif
+
+#if !defined(HIPONY_ENUMERATE_HAS_IO_URING)
+#define HIPONY_ENUMERATE_HAS_IO_URING 0
+#endif
+
+#if HIPONY_ENUMERATE_HAS_PARALLEL && defined(__cpp_lib_execution)
+#define HIPONY_ENUMERATE_HAS_EXECUTION (__cpp_lib_execution >= 201603L)
+#else
+#define HIPONY_ENUMERATE_HAS_EXECUTION false
+#endif
+
+#if HIPONY_ENUMERATE_HAS_PARALLEL
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+#if HIPONY_ENUMERATE_HAS_EXECUTION
+#include <execution>
+#endif
+
 namespace HIPONY_ENUMERATE_NAMESPACE {
 
 #if !defined(HIPONY_AS_ARRAY_HPP_INCLUDED) || HIPONY_ENUMERATE_AS_ARRAY_ENABLED
@@ -140,6 +239,23 @@ struct as_tuple_tag_t {
 HIPONY_ENUMERATE_MAYBE_UNUSED HIPONY_ENUMERATE_CONSTEXPR auto const as_tuple = as_tuple_tag_t{};
 #endif
 
+#if !defined(HIPONY_AS_SPAN_HPP_INCLUDED) || HIPONY_ENUMERATE_AS_SPAN_ENABLED
+#define HIPONY_AS_SPAN_HPP_INCLUDED
+struct as_span_tag_t {
+    explicit as_span_tag_t() = default;
+};
+HIPONY_ENUMERATE_MAYBE_UNUSED HIPONY_ENUMERATE_CONSTEXPR auto const as_span = as_span_tag_t{};
+#endif
+
+#if !defined(HIPONY_AS_CODE_POINTS_HPP_INCLUDED) || HIPONY_ENUMERATE_AS_CODE_POINTS_ENABLED
+#define HIPONY_AS_CODE_POINTS_HPP_INCLUDED
+struct as_code_points_tag_t {
+    explicit as_code_points_tag_t() = default;
+};
+HIPONY_ENUMERATE_MAYBE_UNUSED HIPONY_ENUMERATE_CONSTEXPR auto const as_code_points
+    = as_code_points_tag_t{};
+#endif
+
 namespace hipony_enumerate {
 
 namespace detail {
@@ -180,6 +296,9 @@ using remove_pointer_t = typename std::remove_pointer<T>::type;
 template<typename T>
 using decay_t = typename std::decay<T>::type;
 
+template<bool Value, typename T, typename F>
+using conditional_t = typename std::conditional<Value, T, F>::type;
+
 template<typename T>
 struct sanitize {
     using type = typename detail::remove_cvref_t<T>;
@@ -232,6 +351,27 @@ struct is_string_literal<char16_t const> : std::true_type {};
 template<>
 struct is_string_literal<char32_t const> : std::true_type {};
 
+// NOTE: Code units that can be decoded as UTF-8 or UTF-16
+
+template<typename T>
+struct is_unicode_string : std::false_type {};
+
+template<>
+struct is_unicode_string<char const> : std::true_type {};
+
+template<>
+struct is_unicode_string<wchar_t const> : std::integral_constant<bool, sizeof(wchar_t) == 2> {};
+
+#if HIPONY_ENUMERATE_HAS_CHAR8
+
+template<>
+struct is_unicode_string<char8_t const> : std::true_type {};
+
+#endif
+
+template<>
+struct is_unicode_string<char16_t const> : std::true_type {};
+
 #if HIPONY_ENUMERATE_HAS_RANGES
 
 template<typename T>
@@ -301,6 +441,26 @@ struct size_adapter<Size, T, typename detail::enable_if_t<std::is_integral<Size>
 template<typename... Ts>
 using size_t = typename detail::size_adapter<Ts...>::type;
 
+template<typename T, typename = void>
+struct is_random_access_iterator : std::false_type {};
+
+template<typename T>
+struct is_random_access_iterator<
+    T,
+    typename detail::enable_if_t<std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<T>::iterator_category>::value>> : std::true_type {};
+
+template<typename T, typename = void>
+struct is_bidirectional_iterator : std::false_type {};
+
+template<typename T>
+struct is_bidirectional_iterator<
+    T,
+    typename detail::enable_if_t<std::is_base_of<
+        std::bidirectional_iterator_tag,
+        typename std::iterator_traits<T>::iterator_category>::value>> : std::true_type {};
+
 #if HIPONY_ENUMERATE_HAS_RANGES
 
 template<typename T>
@@ -316,9 +476,9 @@ struct is_random_access_range : std::false_type {};
 template<typename T>
 struct is_random_access_range<
     T,
-    typename detail::enable_if_t<std::is_base_of<
-        std::random_access_iterator_tag,
-        typename std::iterator_traits<T>::iterator_category>::value>> : detail::is_range<T> {};
+    typename detail::enable_if_t<
+        detail::is_random_access_iterator<decltype(std::begin(std::declval<T&>()))>::value>>
+    : detail::is_range<T> {};
 
 #endif
 
@@ -545,6 +705,58 @@ struct zstring_iterator {
     }
 };
 
+#if HIPONY_ENUMERATE_CPP20_OR_GREATER
+
+// NOTE: The view never hands out a null iterator, so reaching the end is a single load and compare
+
+template<typename T>
+struct zstring_sentinel {
+    HIPONY_ENUMERATE_NODISCARD friend constexpr auto
+    operator==(zstring_iterator<T> const& it, zstring_sentinel /*_*/) noexcept -> bool
+    {
+        return *it._ptr == T{};
+    }
+};
+
+#endif
+
+template<typename T>
+struct value_sentinel {
+    T value;
+
+    template<typename It>
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator==(It const& it, value_sentinel const& sentinel)
+        -> decltype(bool(*it == sentinel.value))
+    {
+        return *it == sentinel.value;
+    }
+
+    template<typename It>
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator==(value_sentinel const& sentinel, It const& it)
+        -> decltype(bool(*it == sentinel.value))
+    {
+        return *it == sentinel.value;
+    }
+
+    template<typename It>
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator!=(It const& it, value_sentinel const& sentinel)
+        -> decltype(bool(*it == sentinel.value))
+    {
+        return !(*it == sentinel.value);
+    }
+
+    template<typename It>
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator!=(value_sentinel const& sentinel, It const& it)
+        -> decltype(bool(*it == sentinel.value))
+    {
+        return !(*it == sentinel.value);
+    }
+};
+
 template<typename Char>
 class zstring_view;
 
@@ -567,1278 +779,6243 @@ public:
         : _ptr{ptr}
     {}
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> const_iterator
-    {
-        return {_ptr};
-    }
-
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> const_iterator
-    {
-        return {nullptr};
-    }
-};
+#if HIPONY_ENUMERATE_CPP20_OR_GREATER
 
-template<typename T, typename std::iterator_traits<detail::remove_cvref_t<T>*>::difference_type N>
-struct array {
-    using value_type      = T;
-    using pointer         = T*;
-    using reference       = T&;
-    using const_reference = const T&;
-    using iterator        = T*;
-    using const_iterator  = T const*;
-    using difference_type = typename std::iterator_traits<iterator>::difference_type;
-    using size_type       = typename std::make_unsigned<difference_type>::type;
+    using sentinel       = zstring_sentinel<value_type>;
+    using const_sentinel = sentinel;
 
-    value_type data[N];
+    static constexpr value_type terminator = value_type{};
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept -> iterator
+    HIPONY_ENUMERATE_NODISCARD constexpr auto begin() const noexcept -> const_iterator
     {
-        return data;
+        return {_ptr != nullptr ? _ptr : &terminator};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept -> iterator
+    HIPONY_ENUMERATE_NODISCARD constexpr auto end() const noexcept -> const_sentinel
     {
-        return data + N;
+        return {};
     }
 
+#else
+
     HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
         -> const_iterator
     {
-        return data;
+        return {_ptr};
     }
 
     HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
         -> const_iterator
     {
-        return data + N;
+        return {nullptr};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto size() const noexcept -> size_type
-    {
-        return N;
-    }
+#endif
 };
 
-template<typename T, typename IndexType>
-struct iterator_value {
-    using index_type = IndexType;
-    using value_type = T;
-
-    index_type index;
-    value_type value;
+struct code_point {
+    std::size_t offset;
+    char32_t    value;
 
     HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
-    operator==(iterator_value const& lhs, iterator_value const& rhs) noexcept -> bool
+    operator==(code_point const& lhs, code_point const& rhs) noexcept -> bool
     {
-        return lhs.index == rhs.index && lhs.value == rhs.value;
+        return lhs.offset == rhs.offset && lhs.value == rhs.value;
     }
 
     HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
-    operator!=(iterator_value const& lhs, iterator_value const& rhs) noexcept -> bool
+    operator!=(code_point const& lhs, code_point const& rhs) noexcept -> bool
     {
         return !(lhs == rhs);
     }
 };
 
-template<typename Size, typename InnerIterator>
-struct iterator_base {
-    using inner_iterator = InnerIterator;
-    using size_type      = Size;
+constexpr char32_t replacement_character = 0xFFFD;
 
-    inner_iterator _iterator;
-    size_type      _index;
+// NOTE: Ill-formed input decodes to U+FFFD and consumes the maximal valid subpart, like the
+// decoders in the Unicode Standard (3.9)
 
-    HIPONY_ENUMERATE_CONSTEXPR iterator_base() = default;
+template<typename Char>
+HIPONY_ENUMERATE_CONSTEXPR inline auto decode(
+    std::integral_constant<std::size_t, 1> /*utf8*/,
+    Char const* ptr,
+    Char const* last,
+    char32_t&   cp) noexcept -> std::size_t
+{
+    auto const lead = static_cast<unsigned char>(ptr[0]);
+    if (lead < 0x80) {
+        cp = lead;
+        return 1;
+    }
 
-    HIPONY_ENUMERATE_CONSTEXPR iterator_base(inner_iterator iterator, size_type index)
-        : _iterator{static_cast<decltype(iterator)&&>(iterator)}
-        , _index{index}
-    {}
-};
+    auto          length = std::size_t{};
+    auto          value  = char32_t{};
+    unsigned char lower  = 0x80;
+    unsigned char upper  = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        value  = lead & 0x1Fu;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        value  = lead & 0x0Fu;
+        lower  = lead == 0xE0 ? 0xA0 : lower;
+        upper  = lead == 0xED ? 0x9F : upper;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        value  = lead & 0x07u;
+        lower  = lead == 0xF0 ? 0x90 : lower;
+        upper  = lead == 0xF4 ? 0x8F : upper;
+    } else {
+        cp = replacement_character;
+        return 1;
+    }
 
-template<typename T, typename U, typename Size>
-HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto
-operator==(iterator_base<Size, T> const& lhs, iterator_base<Size, U> const& rhs) noexcept -> bool
-{
-    return lhs._iterator == rhs._iterator;
+    for (std::size_t i = 1; i < length; ++i) {
+        if (ptr + i == last) {
+            cp = replacement_character;
+            return i;
+        }
+        auto const unit = static_cast<unsigned char>(ptr[i]);
+        if (unit < lower || unit > upper) {
+            cp = replacement_character;
+            return i;
+        }
+        value = (value << 6) | (unit & 0x3Fu);
+        lower = 0x80;
+        upper = 0xBF;
+    }
+    cp = value;
+    return length;
 }
 
-template<typename T, typename U, typename Size>
-HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto
-operator!=(iterator_base<Size, T> const& lhs, iterator_base<Size, U> const& rhs) noexcept -> bool
+template<typename Char>
+HIPONY_ENUMERATE_CONSTEXPR inline auto decode(
+    std::integral_constant<std::size_t, 2> /*utf16*/,
+    Char const* ptr,
+    Char const* last,
+    char32_t&   cp) noexcept -> std::size_t
 {
-    return !(lhs == rhs);
+    auto const lead = static_cast<char32_t>(ptr[0]);
+    if (lead < 0xD800 || lead > 0xDFFF) {
+        cp = lead;
+        return 1;
+    }
+    if (lead <= 0xDBFF && ptr + 1 != last) {
+        auto const trail = static_cast<char32_t>(ptr[1]);
+        if (trail >= 0xDC00 && trail <= 0xDFFF) {
+            cp = 0x10000 + ((lead - 0xD800) << 10) + (trail - 0xDC00);
+            return 2;
+        }
+    }
+    cp = replacement_character;
+    return 1;
 }
 
-template<typename Size, typename InnerIterator, typename = void>
-struct iterator : iterator_base<Size, InnerIterator> {
-    using iterator_base<Size, InnerIterator>::iterator_base;
-};
+template<typename Char>
+HIPONY_ENUMERATE_CONSTEXPR inline auto
+decode(Char const* ptr, Char const* last, char32_t& cp) noexcept -> std::size_t
+{
+    return detail::decode(std::integral_constant<std::size_t, sizeof(Char)>{}, ptr, last, cp);
+}
 
-template<typename Size, typename InnerIterator>
-struct iterator<
-    Size,
-    InnerIterator,
-    typename detail::enable_if_t<
-        detail::is_iterator<InnerIterator>::value
-        && !std::is_base_of<
-            std::bidirectional_iterator_tag,
-            typename std::iterator_traits<InnerIterator>::iterator_category>::value>>
-    : iterator_base<Size, InnerIterator> {
-    using inner_iterator  = InnerIterator;
-    using inner_reference = decltype(*inner_iterator{});
+template<typename Char>
+class code_point_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = code_point;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = code_point;
+    using reference         = code_point;
 
-    using iterator_category = std::input_iterator_tag;
-    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
-    using size_type         = Size;
-    using value_type        = iterator_value<inner_reference, size_type>;
-    using pointer           = iterator_value<inner_reference, size_type>;
-    using reference         = iterator_value<inner_reference, size_type>;
+private:
+    Char const* _first  = nullptr;
+    Char const* _ptr    = nullptr;
+    Char const* _last   = nullptr;
+    char32_t    _value  = 0;
+    std::size_t _length = 0;
 
-    using iterator_base<Size, InnerIterator>::iterator_base;
+    HIPONY_ENUMERATE_CONSTEXPR void read() noexcept
+    {
+        if (_ptr != _last) {
+            _length = detail::decode(_ptr, _last, _value);
+        }
+    }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+public:
+    HIPONY_ENUMERATE_CONSTEXPR code_point_iterator() = default;
+
+    HIPONY_ENUMERATE_CONSTEXPR code_point_iterator(
+        Char const* first,
+        Char const* ptr,
+        Char const* last)
+        : _first{first}
+        , _ptr{ptr}
+        , _last{last}
     {
-        return {this->_index, *this->_iterator};
+        read();
     }
 
     HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
         -> reference
     {
-        return {this->_index, *this->_iterator};
+        return {static_cast<std::size_t>(_ptr - _first), _value};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
+    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> code_point_iterator&
     {
-        return {this->_index, *this->_iterator};
+        _ptr += _length;
+        read();
+        return *this;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
-        -> pointer
+    auto operator++(int) noexcept -> code_point_iterator
     {
-        return {this->_index, *this->_iterator};
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
     }
 
-    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> iterator&
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto base() const noexcept -> Char const*
     {
-        this->_iterator++;
-        this->_index++;
-        return *this;
+        return _ptr;
     }
 
-    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept -> iterator
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator==(code_point_iterator const& lhs, code_point_iterator const& rhs) noexcept -> bool
     {
-        auto tmp = *this;
-        ++(*this);
-        return tmp;
+        return lhs._ptr == rhs._ptr;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator!=(code_point_iterator const& lhs, code_point_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
     }
 };
 
-template<typename Size, typename InnerIterator>
-struct iterator<
-    Size,
-    InnerIterator,
-    typename detail::enable_if_t<
-        detail::is_iterator<InnerIterator>::value
-        && std::is_base_of<
-            std::bidirectional_iterator_tag,
-            typename std::iterator_traits<InnerIterator>::iterator_category>::value>>
-    : iterator_base<Size, InnerIterator> {
-    using inner_iterator  = InnerIterator;
-    using inner_reference = decltype(*inner_iterator{});
+template<typename Char>
+class code_point_view {
+public:
+    using value_type     = code_point;
+    using iterator       = code_point_iterator<Char>;
+    using const_iterator = iterator;
 
-    using iterator_category = std::bidirectional_iterator_tag;
-    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
-    using size_type         = Size;
-    using value_type        = iterator_value<inner_reference, size_type>;
-    using pointer           = iterator_value<inner_reference, size_type>;
-    using reference         = iterator_value<inner_reference, size_type>;
+private:
+    Char const* _first;
+    Char const* _last;
 
-    using iterator_base<Size, InnerIterator>::iterator_base;
+public:
+    HIPONY_ENUMERATE_CONSTEXPR code_point_view(Char const* first, Char const* last)
+        : _first{first}
+        , _last{last}
+    {}
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> const_iterator
     {
-        return {this->_index, *this->_iterator};
+        return {_first, _first, _last};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
-        -> reference
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> const_iterator
     {
-        return {this->_index, *this->_iterator};
+        return {_first, _last, _last};
     }
+};
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
-    {
-        return {this->_index, *this->_iterator};
-    }
+// NOTE: Pulls blocks from the streambuf with `sgetn`, so the per-element path is a pointer
+// increment instead of a virtual call
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
-        -> pointer
+constexpr std::size_t stream_block_size = 64 * 1024;
+
+template<typename Char, typename Traits>
+struct stream_blocks;
+
+template<typename Char, typename Traits>
+class stream_iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = Char;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Char const*;
+    using reference         = Char;
+
+private:
+    stream_blocks<Char, Traits> const* _blocks = nullptr;
+
+public:
+    stream_iterator() = default;
+
+    stream_iterator(stream_blocks<Char, Traits> const* blocks) noexcept
+        : _blocks{blocks}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD auto operator*() const noexcept -> reference
     {
-        return {this->_index, *this->_iterator};
+        return *_blocks->ptr;
     }
 
-    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> iterator&
+    auto operator++() -> stream_iterator&
     {
-        this->_iterator++;
-        this->_index++;
+        if (++_blocks->ptr == _blocks->last && !_blocks->fill()) {
+            _blocks = nullptr;
+        }
         return *this;
     }
 
-    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept -> iterator
+    void operator++(int)
     {
-        auto tmp = *this;
         ++(*this);
-        return tmp;
     }
 
-    HIPONY_ENUMERATE_CONSTEXPR auto operator--() noexcept -> iterator&
+    HIPONY_ENUMERATE_NODISCARD auto blocks() const noexcept -> stream_blocks<Char, Traits> const*
     {
-        this->_iterator--;
-        this->_index++;
-        return *this;
+        return _blocks;
     }
 
-    HIPONY_ENUMERATE_NODISCARD auto operator--(int) noexcept -> iterator
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator==(stream_iterator const& lhs, stream_iterator const& rhs) noexcept -> bool
     {
-        auto tmp = *this;
-        ++(*this);
-        return tmp;
+        return lhs._blocks == rhs._blocks;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator!=(stream_iterator const& lhs, stream_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
     }
 };
 
-template<typename Size, typename Container>
-struct range {
-    using value_type = typename detail::remove_rref_t<Container>;
-    using size_type  = Size;
+// NOTE: The iterators point into the view, it shouldn't be moved once the iteration has started
 
-    value_type data;
+template<typename Char, typename Traits>
+struct stream_blocks {
+    using value_type     = Char;
+    using iterator       = stream_iterator<Char, Traits>;
+    using const_iterator = iterator;
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
-        -> iterator<size_type, decltype(data.begin())>
-    {
-        return {data.begin(), 0};
-    }
+    std::basic_istream<Char, Traits>* stream;
+    mutable std::vector<Char>         block;
+    mutable Char const*               ptr  = nullptr;
+    mutable Char const*               last = nullptr;
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
-        -> iterator<size_type, decltype(data.end())>
+    stream_blocks(std::basic_istream<Char, Traits>& stream_)
+        : stream{&stream_}
+        , block(stream_block_size)
+    {}
+
+    auto fill() const -> bool
     {
-        return {data.end(), static_cast<size_type>(-1)};
+        auto const buffer = stream->rdbuf();
+        auto const count
+            = buffer == nullptr
+                  ? std::streamsize{}
+                  : buffer->sgetn(block.data(), static_cast<std::streamsize>(block.size()));
+        ptr  = block.data();
+        last = ptr + count;
+        if (count <= 0) {
+            stream->setstate(std::ios_base::eofbit);
+            return false;
+        }
+        return true;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> iterator<size_type, decltype(data.begin())>
+    HIPONY_ENUMERATE_NODISCARD auto begin() const -> const_iterator
     {
-        return {data.begin(), 0};
+        if (ptr == last && !fill()) {
+            return {};
+        }
+        return {this};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> iterator<size_type, decltype(data.end())>
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
     {
-        return {data.end(), static_cast<size_type>(-1)};
+        return {};
     }
 };
 
-#if HIPONY_ENUMERATE_HAS_RANGES && !defined(__clang__)
+#if HIPONY_ENUMERATE_HAS_STRING_VIEW
 
-template<typename Size, typename Container>
-struct range_view : std::ranges::view_interface<range_view<Size, Container>> {
-    using value_type = typename detail::remove_ref_t<Container>;
-    using size_type  = Size;
+struct csv_dialect {
+    char delimiter;
+    char quote;
 
-    value_type* data;
+    constexpr explicit csv_dialect(char delimiter_ = ',', char quote_ = '"') noexcept
+        : delimiter{delimiter_}
+        , quote{quote_}
+    {}
+};
 
-    HIPONY_ENUMERATE_CONSTEXPR range_view() = default;
+// NOTE: Quoted fields are returned without the outer quotes, doubled quotes inside are left as is
 
-    HIPONY_ENUMERATE_CONSTEXPR range_view(value_type& data_)
-        : data{&data_}
-    {}
+struct csv_field {
+    std::size_t      row;
+    std::size_t      column;
+    std::string_view text;
+    bool             quoted;
+};
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
-        -> iterator<size_type, decltype(data->begin())>
+HIPONY_ENUMERATE_NODISCARD inline auto trailing_zeros(std::uint64_t bits) noexcept -> unsigned
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+    auto count = 0u;
+    for (; (bits & 1) == 0; bits >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// NOTE: Bit `i` is the parity of the set bits at or below `i`, so it marks the bytes inside quotes
+HIPONY_ENUMERATE_NODISCARD inline auto prefix_xor(std::uint64_t bits) noexcept -> std::uint64_t
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+struct csv_masks {
+    std::uint64_t quote;
+    std::uint64_t structural;
+};
+
+// NOTE: Classifies a 64-byte block into bitmasks, bit `i` stands for `block[i]`
+inline auto csv_block(char const* block, csv_dialect const& dialect) noexcept -> csv_masks
+{
+    auto masks = csv_masks{0, 0};
+#if HIPONY_ENUMERATE_HAS_SSE2
+    auto const quote     = _mm_set1_epi8(dialect.quote);
+    auto const delimiter = _mm_set1_epi8(dialect.delimiter);
+    auto const newline   = _mm_set1_epi8('\n');
+    for (auto i = 0; i < 4; ++i) {
+        auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block + 16 * i));
+        auto const quotes
+            = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)));
+        auto const structural = static_cast<std::uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, delimiter), _mm_cmpeq_epi8(chunk, newline))));
+        masks.quote |= std::uint64_t{quotes} << (16 * i);
+        masks.structural |= std::uint64_t{structural} << (16 * i);
+    }
+#else
+    for (auto i = 0; i < 64; ++i) {
+        auto const c = block[i];
+        masks.quote |= std::uint64_t{c == dialect.quote} << i;
+        masks.structural |= std::uint64_t{c == dialect.delimiter || c == '\n'} << i;
+    }
+#endif
+    return masks;
+}
+
+// NOTE: The buffer is scanned 64 bytes at a time, delimiters and newlines outside of quotes are
+// collected into a bitmask and the fields are cut at its set bits. Rows end at '\n', a '\r' before
+// it is dropped and a trailing newline doesn't start another row
+
+class csv_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = csv_field;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = csv_field const*;
+    using reference         = csv_field;
+
+private:
+    char const*   _last   = nullptr;
+    char const*   _base   = nullptr;
+    char const*   _field  = nullptr;
+    char const*   _end    = nullptr;
+    std::uint64_t _bits   = 0;
+    std::uint64_t _inside = 0;
+    std::size_t   _row    = 0;
+    std::size_t   _column = 0;
+    csv_dialect   _dialect;
+
+    void load() noexcept
     {
-        return {data->begin(), 0};
+        auto const available = static_cast<std::size_t>(_last - _base);
+        auto       masks     = csv_masks{};
+        if (available >= 64) {
+            masks = detail::csv_block(_base, _dialect);
+        } else {
+            char block[64] = {};
+            std::memcpy(block, _base, available);
+            masks = detail::csv_block(block, _dialect);
+            masks.structural &= (std::uint64_t{1} << available) - 1;
+        }
+        auto const inside = detail::prefix_xor(masks.quote) ^ _inside;
+        _inside           = std::uint64_t{0} - (inside >> 63);
+        _bits             = masks.structural & ~inside;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
-        -> iterator<size_type, decltype(data->end())>
+    void find() noexcept
     {
-        return {data->end(), static_cast<size_type>(-1)};
+        while (_bits == 0) {
+            if (static_cast<std::size_t>(_last - _base) <= 64) {
+                _end = _last;
+                return;
+            }
+            _base += 64;
+            load();
+        }
+        _end = _base + detail::trailing_zeros(_bits);
+        _bits &= _bits - 1;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> iterator<size_type, decltype(data->begin())>
+public:
+    csv_iterator() = default;
+
+    csv_iterator(std::string_view text, csv_dialect const& dialect) noexcept
+        : _last{text.data() + text.size()}
+        , _base{text.data()}
+        , _dialect{dialect}
     {
-        return {data->begin(), 0};
+        if (text.empty()) {
+            return;
+        }
+        load();
+        _field = _base;
+        find();
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> iterator<size_type, decltype(data->end())>
+    HIPONY_ENUMERATE_NODISCARD auto operator*() const noexcept -> reference
     {
-        return {data->end(), static_cast<size_type>(-1)};
+        auto first = _field;
+        auto last  = _end;
+        if (last != _last && *last == '\n' && last != first && last[-1] == '\r') {
+            --last;
+        }
+        auto const quoted
+            = last - first >= 2 && *first == _dialect.quote && last[-1] == _dialect.quote;
+        if (quoted) {
+            ++first;
+            --last;
+        }
+        return {
+            _row, _column, std::string_view(first, static_cast<std::size_t>(last - first)), quoted};
     }
-};
 
-template<typename Size, typename Container>
-using view = detail::range_view<Size, Container>;
+    auto operator++() noexcept -> csv_iterator&
+    {
+        if (_end == _last) {
+            _field = nullptr;
+            return *this;
+        }
+        if (*_end == '\n') {
+            ++_row;
+            _column = 0;
+        } else {
+            ++_column;
+        }
+        _field = _end + 1;
+        if (_field == _last && _column == 0) {
+            _field = nullptr;
+            return *this;
+        }
+        find();
+        return *this;
+    }
 
-#else
+    auto operator++(int) noexcept -> csv_iterator
+    {
+        auto copy = *this;
+        ++(*this);
+        return copy;
+    }
 
-template<typename Size, typename Container>
-struct basic_view {
-    using value_type = typename detail::remove_ref_t<Container>;
-    using size_type  = Size;
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator==(csv_iterator const& lhs, csv_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._field == rhs._field;
+    }
 
-    value_type* data;
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator!=(csv_iterator const& lhs, csv_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
 
-    HIPONY_ENUMERATE_CONSTEXPR basic_view() = default;
+class csv_view {
+public:
+    using value_type     = csv_field;
+    using iterator       = csv_iterator;
+    using const_iterator = iterator;
 
-    HIPONY_ENUMERATE_CONSTEXPR basic_view(value_type& data_)
-        : data{&data_}
+private:
+    std::string_view _text;
+    csv_dialect      _dialect;
+
+public:
+    csv_view(std::string_view text, csv_dialect const& dialect) noexcept
+        : _text{text}
+        , _dialect{dialect}
     {}
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
-        -> iterator<size_type, decltype(data->begin())>
+    HIPONY_ENUMERATE_NODISCARD auto begin() const noexcept -> const_iterator
     {
-        return {data->begin(), 0};
+        return {_text, _dialect};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
-        -> iterator<size_type, decltype(data->end())>
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
     {
-        return {data->end(), static_cast<size_type>(-1)};
+        return {};
     }
+};
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> iterator<size_type, decltype(data->begin())>
+#endif
+
+#if HIPONY_ENUMERATE_HAS_BYTE
+
+using byte_span = span<std::byte const*, std::byte const*, std::size_t>;
+
+struct length_record {
+    std::size_t offset;
+    byte_span   data;
+};
+
+// NOTE: Prefix decoders return the size of the prefix, or zero if it doesn't fit in the buffer or
+// is malformed
+
+template<typename UInt, bool BigEndian = false>
+struct fixed_prefix {
+    static_assert(std::is_unsigned<UInt>::value, "Length prefix has to be unsigned");
+
+    HIPONY_ENUMERATE_NODISCARD static auto
+    decode(std::byte const* ptr, std::byte const* last, std::uint64_t& length) noexcept
+        -> std::size_t
     {
-        return {data->begin(), 0};
+        if (static_cast<std::size_t>(last - ptr) < sizeof(UInt)) {
+            return 0;
+        }
+        unsigned char bytes[sizeof(UInt)];
+        std::memcpy(bytes, ptr, sizeof(UInt));
+        length = 0;
+        for (std::size_t i = 0; i < sizeof(UInt); ++i) {
+            auto const shift = 8 * (BigEndian ? sizeof(UInt) - 1 - i : i);
+            length |= static_cast<std::uint64_t>(bytes[i]) << shift;
+        }
+        return sizeof(UInt);
     }
+};
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> iterator<size_type, decltype(data->end())>
+// NOTE: Unsigned LEB128 like protobuf, at most 10 bytes. The 10th byte only holds the top bit of
+// a 64-bit length, anything above 1 would overflow
+
+struct varint_prefix {
+    HIPONY_ENUMERATE_NODISCARD static auto
+    decode(std::byte const* ptr, std::byte const* last, std::uint64_t& length) noexcept
+        -> std::size_t
     {
-        return {data->end(), static_cast<size_type>(-1)};
+        auto const available = static_cast<std::size_t>(last - ptr);
+        auto const limit     = available < 10 ? available : std::size_t{10};
+        length               = 0;
+        for (std::size_t i = 0; i < limit; ++i) {
+            auto const byte = static_cast<std::uint64_t>(ptr[i]);
+            if (i == 9 && byte > 1) {
+                return 0;
+            }
+            length |= (byte & 0x7F) << (7 * i);
+            if ((byte & 0x80) == 0) {
+                return i + 1;
+            }
+        }
+        return 0;
     }
 };
 
-template<typename Size, typename Container>
-using view = detail::basic_view<Size, Container>;
+template<typename T>
+struct is_length_prefix : std::false_type {};
 
-#endif
+template<typename UInt, bool BigEndian>
+struct is_length_prefix<fixed_prefix<UInt, BigEndian>> : std::true_type {};
 
-template<typename Size, typename InnerIterator, typename = void>
-class limited_iterator {
-public:
-    using inner_iterator  = InnerIterator;
-    using inner_reference = decltype(*inner_iterator{});
+template<>
+struct is_length_prefix<varint_prefix> : std::true_type {};
 
-    using iterator_category = typename std::iterator_traits<inner_iterator>::iterator_category;
-    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
-    using size_type         = Size;
-    using value_type        = iterator_value<inner_reference, size_type>;
-    using pointer           = iterator_value<inner_reference, size_type>;
-    using reference         = iterator_value<inner_reference, size_type>;
+template<typename T>
+struct is_byte
+    : std::integral_constant<
+          bool,
+          std::is_same<T, char>::value || std::is_same<T, unsigned char>::value
+              || std::is_same<T, std::byte>::value> {};
 
-private:
-    size_type      _max;
-    size_type      _index;
-    inner_iterator _iterator;
+// NOTE: A record whose prefix or payload runs past the end of the buffer ends the enumeration, so
+// a torn write at the tail of a log is skipped. The view reports how far the complete records go
 
+template<typename Prefix>
+class record_iterator {
 public:
-    HIPONY_ENUMERATE_CONSTEXPR limited_iterator() = default;
-
-    HIPONY_ENUMERATE_CONSTEXPR limited_iterator(size_type max, inner_iterator iterator)
-        : _max{max}
-        , _index{0}
-        , _iterator{static_cast<inner_iterator&&>(iterator)}
-    {}
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = length_record;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = length_record const*;
+    using reference         = length_record;
 
-    HIPONY_ENUMERATE_CONSTEXPR
-    limited_iterator(size_type max, size_type index, inner_iterator iterator)
-        : _max{max}
-        , _index{index}
-        , _iterator{static_cast<inner_iterator&&>(iterator)}
-    {}
+private:
+    std::byte const* _origin = nullptr;
+    std::byte const* _ptr    = nullptr;
+    std::byte const* _last   = nullptr;
+    std::byte const* _data   = nullptr;
+    std::size_t      _size   = 0;
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+    void decode() noexcept
     {
-        return {_index, *_iterator};
+        auto       length = std::uint64_t{};
+        auto const prefix = Prefix::decode(_ptr, _last, length);
+        if (prefix == 0 || length > static_cast<std::uint64_t>(_last - _ptr) - prefix) {
+            _ptr = _last;
+            return;
+        }
+        _data = _ptr + prefix;
+        _size = static_cast<std::size_t>(length);
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
-        -> reference
-    {
-        return {_index, *_iterator};
-    }
+public:
+    record_iterator() = default;
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
+    record_iterator(std::byte const* origin, std::byte const* ptr, std::byte const* last) noexcept
+        : _origin{origin}
+        , _ptr{ptr}
+        , _last{last}
     {
-        return {_index, *_iterator};
+        decode();
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
-        -> pointer
+    HIPONY_ENUMERATE_NODISCARD auto operator*() const noexcept -> reference
     {
-        return {_index, *_iterator};
+        return {static_cast<std::size_t>(_ptr - _origin), byte_span{_data, _size}};
     }
 
-    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> limited_iterator&
+    auto operator++() noexcept -> record_iterator&
     {
-        _iterator++;
-        _index++;
+        _ptr = _data + _size;
+        decode();
         return *this;
     }
 
-    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept -> limited_iterator
+    auto operator++(int) noexcept -> record_iterator
     {
-        auto tmp = *this;
+        auto copy = *this;
         ++(*this);
-        return tmp;
+        return copy;
     }
 
-    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
-    operator==(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator==(record_iterator const& lhs, record_iterator const& rhs) noexcept -> bool
     {
-        return lhs._index == rhs._index || lhs._iterator == rhs._iterator;
+        return lhs._ptr == rhs._ptr;
     }
 
-    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
-    operator!=(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator!=(record_iterator const& lhs, record_iterator const& rhs) noexcept -> bool
     {
         return !(lhs == rhs);
     }
 };
 
-template<typename Size, typename InnerIterator>
-class limited_iterator<
-    Size,
-    InnerIterator,
-    typename detail::enable_if_t<std::is_base_of<
-        std::bidirectional_iterator_tag,
-        typename std::iterator_traits<InnerIterator>::iterator_category>::value>> {
+template<typename Prefix>
+class record_view {
 public:
-    using inner_iterator  = InnerIterator;
-    using inner_reference = decltype(*inner_iterator{});
-
-    using iterator_category = typename std::iterator_traits<inner_iterator>::iterator_category;
-    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
-    using size_type         = Size;
-    using value_type        = iterator_value<inner_reference, size_type>;
-    using pointer           = iterator_value<inner_reference, size_type>;
-    using reference         = iterator_value<inner_reference, size_type>;
+    using value_type     = length_record;
+    using iterator       = record_iterator<Prefix>;
+    using const_iterator = iterator;
 
 private:
-    size_type      _max;
-    size_type      _index;
-    inner_iterator _iterator;
+    std::byte const* _first;
+    std::byte const* _last;
 
 public:
-    HIPONY_ENUMERATE_CONSTEXPR limited_iterator() = default;
-
-    HIPONY_ENUMERATE_CONSTEXPR limited_iterator(size_type max, inner_iterator iterator)
-        : _max{max}
-        , _index{0}
-        , _iterator{static_cast<inner_iterator&&>(iterator)}
+    record_view(std::byte const* first, std::byte const* last) noexcept
+        : _first{first}
+        , _last{last}
     {}
 
-    HIPONY_ENUMERATE_CONSTEXPR
-    limited_iterator(size_type max, size_type index, inner_iterator iterator)
-        : _max{max}
-        , _index{index}
-        , _iterator{static_cast<inner_iterator&&>(iterator)}
-    {}
+    HIPONY_ENUMERATE_NODISCARD auto begin() const noexcept -> const_iterator
+    {
+        return {_first, _first, _last};
+    }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
     {
-        return {_index, *_iterator};
+        return {_first, _last, _last};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
-        -> reference
+    // NOTE: Bytes covered by complete records, only the prefixes are read to find it
+    HIPONY_ENUMERATE_NODISCARD auto consumed() const noexcept -> std::size_t
     {
-        return {_index, *_iterator};
+        auto ptr = _first;
+        for (;;) {
+            auto       length = std::uint64_t{};
+            auto const prefix = Prefix::decode(ptr, _last, length);
+            if (prefix == 0 || length > static_cast<std::uint64_t>(_last - ptr) - prefix) {
+                return static_cast<std::size_t>(ptr - _first);
+            }
+            ptr += prefix + static_cast<std::size_t>(length);
+        }
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
+    // NOTE: False when the buffer ends in a torn or malformed record
+    HIPONY_ENUMERATE_NODISCARD auto clean() const noexcept -> bool
     {
-        return {_index, *_iterator};
+        return consumed() == static_cast<std::size_t>(_last - _first);
     }
+};
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
-        -> pointer
+#endif
+
+#if HIPONY_ENUMERATE_HAS_FILES
+
+struct prefetch_stats {
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
+};
+
+struct prefetch_policy {
+    std::size_t     window;
+    bool            release;
+    prefetch_stats* stats;
+
+    constexpr explicit prefetch_policy(
+        std::size_t window_ = 0, bool release_ = false, prefetch_stats* stats_ = nullptr) noexcept
+        : window{window_}
+        , release{release_}
+        , stats{stats_}
+    {}
+};
+
+// NOTE: Keeps `window` bytes ahead of the cursor advised with MADV_WILLNEED, re-arming every half
+// window so the kernel reads ahead while the current half is processed. With `release` the pages
+// fully behind the cursor are dropped with MADV_DONTNEED, only ever the whole pages inside
+// [first, last). That's only safe for a private read-only file mapping, which faults them back in
+// from the page cache if they are touched again. Hits and misses are the pages found resident or
+// not by `mincore` just before they are advised, it's only sampled when stats are requested
+
+class prefetcher {
+    char const*                _first    = nullptr;
+    char const*                _last     = nullptr;
+    std::uintptr_t             _trigger  = 0;
+    char const*                _advised  = nullptr;
+    char const*                _lower    = nullptr;
+    char const*                _released = nullptr;
+    std::size_t                _page     = 0;
+    std::size_t                _window   = 0;
+    bool                       _release  = false;
+    prefetch_stats*            _stats    = nullptr;
+    std::vector<unsigned char> _resident;
+
+    HIPONY_ENUMERATE_NODISCARD auto floor(char const* ptr) const noexcept -> char const*
     {
-        return {_index, *_iterator};
+        return ptr - (reinterpret_cast<std::uintptr_t>(ptr) & (_page - 1));
     }
 
-    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> limited_iterator&
+    void count(char const* first, std::size_t size)
     {
-        _iterator++;
-        _index++;
-        return *this;
+        _resident.resize((size + _page - 1) / _page);
+        if (::mincore(const_cast<char*>(first), size, _resident.data()) != 0) {
+            return;
+        }
+        for (auto page : _resident) {
+            ++((page & 1) != 0 ? _stats->hits : _stats->misses);
+        }
     }
 
-    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept -> limited_iterator
+    void advance(char const* cursor)
     {
-        auto tmp = *this;
-        ++(*this);
-        return tmp;
+        auto const page  = floor(cursor);
+        auto const ahead = static_cast<std::size_t>(_last - page);
+        auto const until = ahead < _window ? _last : page + _window;
+        if (until > _advised) {
+            auto const size = static_cast<std::size_t>(until - _advised);
+            if (_stats != nullptr) {
+                count(_advised, size);
+            }
+            static_cast<void>(::madvise(const_cast<char*>(_advised), size, MADV_WILLNEED));
+            _advised = until;
+        }
+        if (_release && page > _released) {
+            static_cast<void>(::madvise(
+                const_cast<char*>(_released),
+                static_cast<std::size_t>(page - _released),
+                MADV_DONTNEED));
+            _released = page;
+        }
+        _trigger = ahead <= _window / 2
+                       ? (std::numeric_limits<std::uintptr_t>::max)()
+                       : reinterpret_cast<std::uintptr_t>(page + _window / 2);
     }
 
-    HIPONY_ENUMERATE_CONSTEXPR auto operator--() noexcept -> limited_iterator&
+public:
+    prefetcher() = default;
+
+    prefetcher(void const* first, void const* last, prefetch_policy const& policy)
+        : _last{static_cast<char const*>(last)}
+        , _page{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))}
+        , _release{policy.release}
+        , _stats{policy.stats}
     {
-        _iterator--;
-        _index++;
-        return *this;
+        auto const window = policy.window > 0 ? policy.window : std::size_t{16} << 20;
+        _window           = (std::max)((window + _page - 1) & ~(_page - 1), 2 * _page);
+        _first            = first == nullptr ? nullptr : floor(static_cast<char const*>(first));
+        // NOTE: The page holding `first` may hold bytes before it, releasing starts at the next one
+        _lower = _first == nullptr || _first == first ? _first : _first + _page;
+        restart();
     }
 
-    HIPONY_ENUMERATE_NODISCARD auto operator--(int) noexcept -> limited_iterator
+    void restart() noexcept
     {
-        auto tmp = *this;
-        ++(*this);
-        return tmp;
+        _trigger  = _first == nullptr ? (std::numeric_limits<std::uintptr_t>::max)()
+                                      : reinterpret_cast<std::uintptr_t>(_first);
+        _advised  = _first;
+        _released = _lower;
     }
 
-    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
-    operator==(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    // NOTE: Bytes from `cursor` until the next call to `touch` does any work
+    HIPONY_ENUMERATE_NODISCARD auto distance(void const* cursor) const noexcept -> std::uintptr_t
     {
-        return lhs._index == rhs._index || lhs._iterator == rhs._iterator;
+        auto const ptr = reinterpret_cast<std::uintptr_t>(cursor);
+        return _trigger > ptr ? _trigger - ptr : 0;
     }
 
-    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
-    operator!=(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    // NOTE: A single comparison on the hot path, the system calls are made once per half window
+    void touch(void const* cursor)
     {
-        return !(lhs == rhs);
+        if (reinterpret_cast<std::uintptr_t>(cursor) >= _trigger) {
+            advance(static_cast<char const*>(cursor));
+        }
     }
 };
 
-template<typename Size, typename Container, typename = void>
-struct limited_range {
-    using value_type = typename detail::remove_rref_t<Container>;
-    using size_type  = Size;
+template<typename T>
+class prefetch_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = T const*;
+    using reference         = T const&;
 
-    struct impl_t {
-        value_type data;
-        size_type  size;
+private:
+    T const*    _ptr        = nullptr;
+    prefetcher* _prefetcher = nullptr;
 
-        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
-        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type&& data_, size_type size_)
-            : data{static_cast<decltype(data_)&&>(data_)}
-            , size{size_}
-        {}
-    } impl;
+public:
+    prefetch_iterator() = default;
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
-        -> limited_iterator<size_type, decltype(impl.data.begin())>
-    {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.data.begin()};
-    }
+    prefetch_iterator(T const* ptr, prefetcher* prefetcher_) noexcept
+        : _ptr{ptr}
+        , _prefetcher{prefetcher_}
+    {}
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
-        -> limited_iterator<size_type, decltype(impl.data.end())>
+    HIPONY_ENUMERATE_NODISCARD auto operator*() const noexcept -> reference
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.size, impl.data.end()};
+        return *_ptr;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> limited_iterator<size_type, decltype(impl.data.begin())>
+    auto operator++() noexcept -> prefetch_iterator&
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.data.begin()};
+        _prefetcher->touch(++_ptr);
+        return *this;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> limited_iterator<size_type, decltype(impl.data.end())>
+    auto operator++(int) noexcept -> prefetch_iterator
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.size, impl.data.end()};
+        auto copy = *this;
+        ++(*this);
+        return copy;
     }
-};
-
-template<typename Size, typename Container>
-struct limited_range<
-    Size,
-    Container,
-    typename detail::enable_if_t<
-        detail::is_sized_range<detail::remove_cvref_t<Container>>::value
-        && detail::is_random_access_range<detail::remove_cvref_t<Container>>::value>> {
-    using value_type      = typename detail::remove_rref_t<Container>;
-    using inner_iterator  = typename detail::remove_cvref_t<Container>::iterator;
-    using difference_type = typename std::iterator_traits<inner_iterator>::difference_type;
-    using size_type       = Size;
 
-    struct impl_t {
-        value_type      data;
-        difference_type size;
-
-        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
-        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type&& data_, size_type size_)
-            : data{static_cast<decltype(data_)&&>(data_)}
-            , size{
-                  static_cast<difference_type>(size_) < static_cast<difference_type>(data.size())
-                      ? static_cast<difference_type>(size_)
-                      : static_cast<difference_type>(data.size())}
-        {}
-    } impl;
-
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
-        -> iterator<size_type, decltype(impl.data.begin())>
+    HIPONY_ENUMERATE_NODISCARD auto base() const noexcept -> T const*
     {
-        return {impl.data.begin(), 0};
+        return _ptr;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
-        -> iterator<size_type, decltype(impl.data.begin())>
+    HIPONY_ENUMERATE_NODISCARD auto get_prefetcher() const noexcept -> prefetcher*
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {
-            impl.data.begin() + static_cast<difference_type>(impl.size),
-            static_cast<size_type>(-1)};
+        return _prefetcher;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> iterator<size_type, decltype(impl.data.begin())>
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator==(prefetch_iterator const& lhs, prefetch_iterator const& rhs) noexcept -> bool
     {
-        return {impl.data.begin(), 0};
+        return lhs._ptr == rhs._ptr;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> iterator<size_type, decltype(impl.data.begin())>
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator!=(prefetch_iterator const& lhs, prefetch_iterator const& rhs) noexcept -> bool
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {
-            impl.data.begin() + static_cast<difference_type>(impl.size),
-            static_cast<size_type>(-1)};
+        return !(lhs == rhs);
     }
 };
 
-#if HIPONY_ENUMERATE_HAS_RANGES && !defined(__clang__)
-
-template<typename Size, typename Container, typename = void>
-struct limited_range_view : std::ranges::view_interface<limited_range_view<Size, Container>> {
-    using value_type = typename detail::remove_ref_t<Container>;
-    using size_type  = Size;
-
-    struct impl_t {
-        value_type* data;
-        size_type   size;
+// NOTE: The iterators point into the view, it shouldn't be moved once the iteration has started
 
-        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
-        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type& data_, size_type size_)
-            : data{&data_}
-            , size{size_}
-        {}
-    } impl;
+template<typename T>
+struct prefetch_view {
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using iterator       = prefetch_iterator<T>;
+    using const_iterator = iterator;
 
-    HIPONY_ENUMERATE_CONSTEXPR limited_range_view() = default;
+    T const*           first;
+    T const*           last;
+    mutable prefetcher state;
 
-    HIPONY_ENUMERATE_CONSTEXPR limited_range_view(impl_t impl_)
-        : impl{static_cast<impl_t&&>(impl_)}
+    prefetch_view(T const* first_, T const* last_, prefetch_policy const& policy)
+        : first{first_}
+        , last{last_}
+        , state{first_, last_, policy}
     {}
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
-        -> limited_iterator<size_type, decltype(impl.data->begin())>
-    {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.data->begin()};
-    }
-
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
-        -> limited_iterator<size_type, decltype(impl.data->end())>
+    HIPONY_ENUMERATE_NODISCARD auto begin() const -> const_iterator
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.size, impl.data->end()};
+        state.restart();
+        state.touch(first);
+        return {first, &state};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> limited_iterator<size_type, decltype(impl.data->begin())>
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.data->begin()};
+        return {last, &state};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> limited_iterator<size_type, decltype(impl.data->end())>
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> size_type
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.size, impl.data->end()};
+        return static_cast<size_type>(last - first);
     }
 };
 
-template<typename Size, typename Container>
-struct limited_range_view<
-    Size,
-    Container,
-    typename detail::enable_if_t<
-        detail::is_sized_range<detail::remove_cvref_t<Container>>::value
-        && detail::is_random_access_range<detail::remove_cvref_t<Container>>::value>>
-    : std::ranges::view_interface<limited_range_view<Size, Container>> {
-    using value_type      = typename detail::remove_rref_t<Container>;
-    using inner_iterator  = typename detail::remove_cvref_t<Container>::iterator;
-    using difference_type = typename std::iterator_traits<inner_iterator>::difference_type;
-    using size_type       = Size;
+#endif
 
-    struct impl_t {
-        value_type*     data;
-        difference_type size;
+#if HIPONY_ENUMERATE_HAS_STRING_VIEW
 
-        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
-        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type& data_, size_type size_)
-            : data{&data_}
-            , size{
-                  static_cast<difference_type>(size_) < static_cast<difference_type>(data->size())
-                      ? static_cast<difference_type>(size_)
-                      : static_cast<difference_type>(data->size())}
-        {}
-    } impl;
+// NOTE: Lines are split like std::getline, a trailing newline doesn't start another line
 
-    HIPONY_ENUMERATE_CONSTEXPR limited_range_view() = default;
+class line_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::string_view;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::string_view;
+    using reference         = std::string_view;
 
-    HIPONY_ENUMERATE_CONSTEXPR limited_range_view(impl_t impl_)
-        : impl{static_cast<impl_t&&>(impl_)}
-    {}
+private:
+    char const* _ptr  = nullptr;
+    char const* _eol  = nullptr;
+    char const* _last = nullptr;
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
-        -> iterator<size_type, decltype(impl.data->begin())>
+    void find() noexcept
     {
-        return {impl.data->begin(), 0};
+        if (_ptr == _last) {
+            _eol = _last;
+            return;
+        }
+        auto const eol = std::memchr(_ptr, '\n', static_cast<std::size_t>(_last - _ptr));
+        _eol           = eol != nullptr ? static_cast<char const*>(eol) : _last;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
-        -> iterator<size_type, decltype(impl.data->begin())>
+public:
+    line_iterator() = default;
+
+    line_iterator(char const* ptr, char const* last) noexcept
+        : _ptr{ptr}
+        , _last{last}
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {
-            impl.data->begin() + static_cast<difference_type>(impl.size),
-            static_cast<size_type>(-1)};
+        find();
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> iterator<size_type, decltype(impl.data->begin())>
+    HIPONY_ENUMERATE_NODISCARD auto operator*() const noexcept -> reference
     {
-        return {impl.data->begin(), 0};
+        return {_ptr, static_cast<std::size_t>(_eol - _ptr)};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> iterator<size_type, decltype(impl.data->begin())>
+    auto operator++() noexcept -> line_iterator&
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {
-            impl.data->begin() + static_cast<difference_type>(impl.size),
-            static_cast<size_type>(-1)};
+        _ptr = _eol == _last ? _last : _eol + 1;
+        find();
+        return *this;
     }
-};
 
-template<typename Size, typename Container>
-using limited_view = detail::limited_range_view<Size, Container>;
-
-#else
+    auto operator++(int) noexcept -> line_iterator
+    {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
+    }
 
-template<typename Size, typename Container, typename = void>
-struct limited_basic_view {
-    using value_type = typename detail::remove_ref_t<Container>;
-    using size_type  = Size;
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator==(line_iterator const& lhs, line_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._ptr == rhs._ptr;
+    }
 
-    struct impl_t {
-        value_type* data;
-        size_type   size;
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator!=(line_iterator const& lhs, line_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
 
-        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
-        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type& data_, size_type size_)
-            : data{&data_}
-            , size{size_}
-        {}
-    } impl;
+template<typename Storage>
+struct lines {
+    using value_type     = std::string_view;
+    using iterator       = line_iterator;
+    using const_iterator = iterator;
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
-        -> limited_iterator<size_type, decltype(impl.data->begin())>
+    Storage storage;
+
+    HIPONY_ENUMERATE_NODISCARD auto begin() const noexcept -> const_iterator
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.data->begin()};
+        return {storage.data(), storage.data() + storage.size()};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
-        -> limited_iterator<size_type, decltype(impl.data->end())>
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.size, impl.data->end()};
+        return {storage.data() + storage.size(), storage.data() + storage.size()};
     }
+};
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> limited_iterator<size_type, decltype(impl.data->begin())>
+// NOTE: Line `i` spans from `offsets[i]` up to the newline right before `offsets[i + 1]`, the last
+// offset is one past a virtual newline at the end of the text when there is no real one
+
+class indexed_line_iterator {
+public:
+    using value_type        = std::string_view;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = std::string_view;
+    using reference         = std::string_view;
+    using iterator_category = std::random_access_iterator_tag;
+
+private:
+    char const*          _text   = nullptr;
+    std::uint64_t const* _offset = nullptr;
+
+public:
+    indexed_line_iterator() = default;
+
+    indexed_line_iterator(char const* text, std::uint64_t const* offset) noexcept
+        : _text{text}
+        , _offset{offset}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD auto operator*() const noexcept -> reference
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.data->begin()};
+        return {_text + _offset[0], static_cast<std::size_t>(_offset[1] - _offset[0] - 1)};
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> limited_iterator<size_type, decltype(impl.data->end())>
+    HIPONY_ENUMERATE_NODISCARD auto operator[](difference_type n) const noexcept -> reference
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {impl.size, impl.size, impl.data->end()};
+        return *(*this + n);
     }
-};
 
-template<typename Size, typename Container>
-struct limited_basic_view<
-    Size,
-    Container,
-    typename detail::enable_if_t<
-        detail::is_sized_range<detail::remove_cvref_t<Container>>::value
-        && detail::is_random_access_range<detail::remove_cvref_t<Container>>::value>> {
-    using value_type      = typename detail::remove_rref_t<Container>;
-    using inner_iterator  = typename detail::remove_cvref_t<Container>::iterator;
-    using difference_type = typename std::iterator_traits<inner_iterator>::difference_type;
-    using size_type       = Size;
+    auto operator++() noexcept -> indexed_line_iterator&
+    {
+        ++_offset;
+        return *this;
+    }
 
-    struct impl_t {
-        value_type*     data;
-        difference_type size;
+    auto operator++(int) noexcept -> indexed_line_iterator
+    {
+        auto tmp = *this;
+        ++_offset;
+        return tmp;
+    }
 
-        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
-        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type& data_, size_type size_)
-            : data{&data_}
-            , size{
-                  static_cast<difference_type>(size_) < static_cast<difference_type>(data->size())
-                      ? static_cast<difference_type>(size_)
-                      : static_cast<difference_type>(data->size())}
-        {}
-    } impl;
+    auto operator--() noexcept -> indexed_line_iterator&
+    {
+        --_offset;
+        return *this;
+    }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
-        -> iterator<size_type, decltype(impl.data->begin())>
+    auto operator--(int) noexcept -> indexed_line_iterator
     {
-        return {impl.data->begin(), 0};
+        auto tmp = *this;
+        --_offset;
+        return tmp;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
-        -> iterator<size_type, decltype(impl.data->begin())>
+    auto operator+=(difference_type n) noexcept -> indexed_line_iterator&
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {
-            impl.data->begin() + static_cast<difference_type>(impl.size),
-            static_cast<size_type>(-1)};
+        _offset += n;
+        return *this;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
-        -> iterator<size_type, decltype(impl.data->begin())>
+    auto operator-=(difference_type n) noexcept -> indexed_line_iterator&
     {
-        return {impl.data->begin(), 0};
+        _offset -= n;
+        return *this;
     }
 
-    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
-        -> iterator<size_type, decltype(impl.data->begin())>
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator+(indexed_line_iterator it, difference_type n) noexcept -> indexed_line_iterator
     {
-        assert(impl.size >= 0 && "Size is negative");
-        return {
-            impl.data->begin() + static_cast<difference_type>(impl.size),
-            static_cast<size_type>(-1)};
+        return {it._text, it._offset + n};
     }
-};
 
-template<typename Size, typename Container>
-using limited_view = detail::limited_basic_view<Size, Container>;
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator+(difference_type n, indexed_line_iterator it) noexcept -> indexed_line_iterator
+    {
+        return {it._text, it._offset + n};
+    }
 
-#endif
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator-(indexed_line_iterator it, difference_type n) noexcept -> indexed_line_iterator
+    {
+        return {it._text, it._offset - n};
+    }
 
-template<typename Size, typename T, typename U = T>
-struct tuple_wrapper;
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator-(indexed_line_iterator const& lhs, indexed_line_iterator const& rhs) noexcept
+        -> difference_type
+    {
+        return lhs._offset - rhs._offset;
+    }
 
-template<typename Size, typename T, template<typename...> class Tuple, typename... Ts>
-struct tuple_wrapper<Size, T, Tuple<Ts...>> {
-    using tuple_type = typename detail::remove_rref_t<T>;
-    using size_type  = Size;
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator==(indexed_line_iterator const& lhs, indexed_line_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._offset == rhs._offset;
+    }
 
-    tuple_type data;
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator!=(indexed_line_iterator const& lhs, indexed_line_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
 
-    template<typename F>
-    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator<(indexed_line_iterator const& lhs, indexed_line_iterator const& rhs) noexcept -> bool
     {
-        do_each<F, 0, Ts...>(static_cast<F&&>(f));
+        return lhs._offset < rhs._offset;
     }
 
-private:
-    template<typename F, size_type N>
-    HIPONY_ENUMERATE_CONSTEXPR void do_each(F&& /*f*/)
-    {}
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator>(indexed_line_iterator const& lhs, indexed_line_iterator const& rhs) noexcept -> bool
+    {
+        return rhs < lhs;
+    }
 
-    template<typename F, size_type N, typename Arg, typename... Args>
-    HIPONY_ENUMERATE_CONSTEXPR void do_each(F&& f)
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator<=(indexed_line_iterator const& lhs, indexed_line_iterator const& rhs) noexcept -> bool
     {
-        f(N, std::get<N>(data));
-        do_each<F, N + 1, Args...>(static_cast<F&&>(f));
+        return !(rhs < lhs);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator>=(indexed_line_iterator const& lhs, indexed_line_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs < rhs);
     }
 };
 
-#if HIPONY_ENUMERATE_HAS_AGGREGATES
+template<typename Storage>
+struct indexed_lines {
+    using value_type     = std::string_view;
+    using iterator       = indexed_line_iterator;
+    using const_iterator = iterator;
 
-template<typename Size, typename T>
-struct aggregate_wrapper {
-    using aggregate_type = typename detail::remove_rref_t<T>;
-    using size_type      = Size;
+    Storage              storage;
+    std::uint64_t const* offsets;
+    std::size_t          count;
 
-    aggregate_type data;
+    HIPONY_ENUMERATE_NODISCARD auto begin() const noexcept -> const_iterator
+    {
+        return {storage.data(), offsets};
+    }
 
-    template<typename F>
-    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
     {
-        using tuple_type = decltype(boost::pfr::structure_tie(data));
-        detail::tuple_wrapper<
-            Size,
-            detail::remove_rref_t<tuple_type>,
-            detail::remove_cvref_t<tuple_type>>{boost::pfr::structure_tie(data)}
-            .each(static_cast<F&&>(f));
+        return {storage.data(), offsets + count};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> std::size_t
+    {
+        return count;
     }
 };
 
 #endif
 
-struct variadic_tuple_tag_t {};
-struct variadic_array_tag_t {};
-struct iterator_pointer_tag_t {};
-struct iterator_tag_t {};
-struct container_tag_t {};
-struct container_size_tag_t {};
-struct tuple_tag_t {};
-struct pointer_tag_t {};
-struct string_tag_t {};
-struct array_tag_t {};
+template<typename T, typename std::iterator_traits<detail::remove_cvref_t<T>*>::difference_type N>
+struct array {
+    using value_type      = T;
+    using pointer         = T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using iterator        = T*;
+    using const_iterator  = T const*;
+    using difference_type = typename std::iterator_traits<iterator>::difference_type;
+    using size_type       = typename std::make_unsigned<difference_type>::type;
 
-#if HIPONY_ENUMERATE_HAS_AGGREGATES
-struct aggregate_tag_t {};
-#endif
+    value_type data[N];
 
-template<typename Size, typename T, typename = void, typename...>
-struct tag;
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept -> iterator
+    {
+        return data;
+    }
 
-template<typename Size, typename T, typename T1>
-struct tag<
-    Size,
-    T,
-    typename detail::enable_if_t<
-        std::is_same<T, T1>::value && detail::is_iterator<T>::value && std::is_pointer<T>::value>,
-    T1> {
-    using type = iterator_pointer_tag_t;
-};
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept -> iterator
+    {
+        return data + N;
+    }
 
-template<typename Size, typename T, typename Sentinel>
-struct tag<
-    Size,
-    T,
-    typename detail::enable_if_t<
-        detail::sentinel_for<Sentinel, T>::value && detail::is_iterator<T>::value
-        && (!std::is_pointer<T>::value || !std::is_pointer<Sentinel>::value)>,
-    Sentinel> {
-    using type = iterator_tag_t;
-};
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> const_iterator
+    {
+        return data;
+    }
 
-template<typename Size, typename T>
-struct tag<
-    Size,
-    T,
-    typename detail::enable_if_t<!std::is_array<T>::value && detail::is_range<T>::value>> {
-    using type = container_tag_t;
-};
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> const_iterator
+    {
+        return data + N;
+    }
 
-template<typename Size, typename T, typename TSize>
-struct tag<
-    Size,
-    T,
-    typename detail::enable_if_t<
-        !std::is_array<T>::value && detail::is_range<T>::value && std::is_integral<Size>::value
-        && std::is_convertible<TSize, Size>::value>,
-    TSize> {
-    static_assert(
-        !detail::is_narrow_convertible<TSize, Size>::value,
-        "Narrowing conversions for Size are not allowed. Either cast it explicitly or use the "
-        "`_as<Size>` overload.");
-    using type = container_size_tag_t;
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto size() const noexcept -> size_type
+    {
+        return N;
+    }
 };
 
-template<typename Size, typename T>
-struct tag<
-    Size,
-    T,
-    typename detail::enable_if_t<
-        detail::is_tuple<detail::decay_t<T>>::value && !detail::is_range<T>::value>> {
-    using type = tuple_tag_t;
+// NOTE: Implicitly constructible from an lvalue so an array of them can be brace-initialized with
+// the original objects
+
+template<typename T>
+struct reference {
+    T* ptr;
+
+    HIPONY_ENUMERATE_CONSTEXPR reference(T& value) noexcept
+        : ptr{&value}
+    {}
 };
 
-template<typename Size, typename T, typename TSize>
-struct tag<
-    Size,
-    T*,
+template<typename T>
+class indirect_iterator {
+public:
+    using value_type        = typename std::remove_cv<T>::type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = T*;
+    using reference         = T&;
+    using iterator_category = std::random_access_iterator_tag;
+
+private:
+    detail::reference<T> const* _ptr;
+
+public:
+    HIPONY_ENUMERATE_CONSTEXPR indirect_iterator() noexcept
+        : _ptr{nullptr}
+    {}
+
+    HIPONY_ENUMERATE_CONSTEXPR indirect_iterator(detail::reference<T> const* ptr) noexcept
+        : _ptr{ptr}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
+        -> reference
+    {
+        return *_ptr->ptr;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
+        -> pointer
+    {
+        return _ptr->ptr;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto
+    operator[](difference_type n) const noexcept -> reference
+    {
+        return *_ptr[n].ptr;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> indirect_iterator&
+    {
+        ++_ptr;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator++(int) noexcept -> indirect_iterator
+    {
+        auto tmp = *this;
+        ++_ptr;
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator--() noexcept -> indirect_iterator&
+    {
+        --_ptr;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator--(int) noexcept -> indirect_iterator
+    {
+        auto tmp = *this;
+        --_ptr;
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator+=(difference_type n) noexcept -> indirect_iterator&
+    {
+        _ptr += n;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator-=(difference_type n) noexcept -> indirect_iterator&
+    {
+        _ptr -= n;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator+(indirect_iterator it, difference_type n) noexcept -> indirect_iterator
+    {
+        return {it._ptr + n};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator+(difference_type n, indirect_iterator it) noexcept -> indirect_iterator
+    {
+        return {it._ptr + n};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator-(indirect_iterator it, difference_type n) noexcept -> indirect_iterator
+    {
+        return {it._ptr - n};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator-(indirect_iterator const& lhs, indirect_iterator const& rhs) noexcept
+        -> difference_type
+    {
+        return lhs._ptr - rhs._ptr;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator==(indirect_iterator const& lhs, indirect_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._ptr == rhs._ptr;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator!=(indirect_iterator const& lhs, indirect_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator<(indirect_iterator const& lhs, indirect_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._ptr < rhs._ptr;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator>(indirect_iterator const& lhs, indirect_iterator const& rhs) noexcept -> bool
+    {
+        return rhs < lhs;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator<=(indirect_iterator const& lhs, indirect_iterator const& rhs) noexcept -> bool
+    {
+        return !(rhs < lhs);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator>=(indirect_iterator const& lhs, indirect_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs < rhs);
+    }
+};
+
+// NOTE: Holds the addresses of the enumerated objects, constness follows the objects themselves
+// like it does for a tuple of references
+
+template<typename T, std::size_t N>
+struct reference_array {
+    using value_type      = T;
+    using pointer         = T*;
+    using reference       = T&;
+    using const_reference = T&;
+    using iterator        = detail::indirect_iterator<T>;
+    using const_iterator  = iterator;
+    using difference_type = typename iterator::difference_type;
+    using size_type       = std::size_t;
+
+    detail::reference<T> data[N];
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> const_iterator
+    {
+        return {data};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> const_iterator
+    {
+        return {data + N};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto size() const noexcept -> size_type
+    {
+        return N;
+    }
+};
+
+template<typename T, T... Is>
+struct integer_sequence {
+    using type = integer_sequence;
+};
+
+template<std::size_t... Is>
+using index_sequence = detail::integer_sequence<std::size_t, Is...>;
+
+template<bool... Values>
+struct all_of
+    : std::is_same<
+          detail::integer_sequence<bool, true, Values...>,
+          detail::integer_sequence<bool, Values..., true>> {};
+
+template<typename Lhs, typename Rhs>
+struct concat_sequence;
+
+template<typename T, T... Lhs, T... Rhs>
+struct concat_sequence<detail::integer_sequence<T, Lhs...>, detail::integer_sequence<T, Rhs...>>
+    : detail::integer_sequence<T, Lhs..., (static_cast<T>(sizeof...(Lhs)) + Rhs)...> {};
+
+// NOTE: Halving keeps the instantiation depth logarithmic in N
+
+template<std::size_t N>
+struct make_index_sequence_impl
+    : detail::concat_sequence<
+          typename detail::make_index_sequence_impl<N / 2>::type,
+          typename detail::make_index_sequence_impl<N - N / 2>::type> {};
+
+template<>
+struct make_index_sequence_impl<0> : detail::index_sequence<> {};
+
+template<>
+struct make_index_sequence_impl<1> : detail::index_sequence<0> {};
+
+template<std::size_t N>
+using make_index_sequence = typename detail::make_index_sequence_impl<N>::type;
+
+template<typename T, typename = void>
+struct static_extent {};
+
+template<typename It, typename Size, Size N>
+struct static_extent<
+    detail::span<It, It, Size, N>,
+    typename detail::enable_if_t<N != detail::dynamic_extent<Size>::value>>
+    : std::integral_constant<std::size_t, static_cast<std::size_t>(N)> {};
+
+template<typename T, typename std::iterator_traits<detail::remove_cvref_t<T>*>::difference_type N>
+struct static_extent<detail::array<T, N>>
+    : std::integral_constant<std::size_t, static_cast<std::size_t>(N)> {};
+
+template<typename T, std::size_t N>
+struct static_extent<detail::reference_array<T, N>> : std::integral_constant<std::size_t, N> {};
+
+template<typename T>
+struct static_extent<T, typename detail::enable_if_t<detail::is_tuple<T>::value>>
+    : std::integral_constant<std::size_t, std::tuple_size<T>::value> {};
+
+template<typename Size, typename Iterator, typename F, std::size_t... Is>
+HIPONY_ENUMERATE_CONSTEXPR inline void
+unrolled_each(Iterator first, F& f, detail::index_sequence<Is...> /*indices*/)
+{
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using swallow         = int[];
+    static_cast<void>(swallow{
+        0,
+        (static_cast<void>(f(
+             std::integral_constant<Size, static_cast<Size>(Is)>{},
+             first[static_cast<difference_type>(Is)])),
+         0)...});
+}
+
+template<typename T, typename IndexType>
+struct iterator_value {
+    using index_type = IndexType;
+    using value_type = T;
+
+    index_type index;
+    value_type value;
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator==(iterator_value const& lhs, iterator_value const& rhs) noexcept -> bool
+    {
+        return lhs.index == rhs.index && lhs.value == rhs.value;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator!=(iterator_value const& lhs, iterator_value const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
+
+template<typename Size, typename InnerIterator>
+struct iterator_base {
+    using inner_iterator = InnerIterator;
+    using size_type      = Size;
+
+    inner_iterator _iterator;
+    size_type      _index;
+
+    HIPONY_ENUMERATE_CONSTEXPR iterator_base() = default;
+
+    HIPONY_ENUMERATE_CONSTEXPR iterator_base(inner_iterator iterator, size_type index)
+        : _iterator{static_cast<decltype(iterator)&&>(iterator)}
+        , _index{index}
+    {}
+};
+
+template<typename T, typename U, typename Size>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto
+operator==(iterator_base<Size, T> const& lhs, iterator_base<Size, U> const& rhs) noexcept -> bool
+{
+    return lhs._iterator == rhs._iterator;
+}
+
+template<typename T, typename U, typename Size>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto
+operator!=(iterator_base<Size, T> const& lhs, iterator_base<Size, U> const& rhs) noexcept -> bool
+{
+    return !(lhs == rhs);
+}
+
+template<typename Size, typename InnerIterator, typename = void>
+struct iterator : iterator_base<Size, InnerIterator> {
+    using iterator_base<Size, InnerIterator>::iterator_base;
+};
+
+template<typename Size, typename InnerIterator>
+struct iterator<
+    Size,
+    InnerIterator,
     typename detail::enable_if_t<
-        std::is_integral<Size>::value && std::is_convertible<TSize, Size>::value>,
-    TSize> {
+        detail::is_iterator<InnerIterator>::value
+        && !std::is_base_of<
+            std::bidirectional_iterator_tag,
+            typename std::iterator_traits<InnerIterator>::iterator_category>::value>>
+    : iterator_base<Size, InnerIterator> {
+    using inner_iterator  = InnerIterator;
+    using inner_reference = decltype(*inner_iterator{});
+
+    using iterator_category = std::input_iterator_tag;
+    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type         = Size;
+    using value_type        = iterator_value<inner_reference, size_type>;
+    using pointer           = iterator_value<inner_reference, size_type>;
+    using reference         = iterator_value<inner_reference, size_type>;
+
+    using iterator_base<Size, InnerIterator>::iterator_base;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
+        -> reference
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
+        -> pointer
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    // NOTE: Input sources may throw while advancing, eg when reading ahead on another thread
+    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept(
+        noexcept(std::declval<inner_iterator&>()++)) -> iterator&
+    {
+        this->_iterator++;
+        this->_index++;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept(
+        noexcept(std::declval<inner_iterator&>()++)) -> iterator
+    {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+};
+
+template<typename Size, typename InnerIterator>
+struct iterator<
+    Size,
+    InnerIterator,
+    typename detail::enable_if_t<
+        detail::is_iterator<InnerIterator>::value
+        && std::is_base_of<
+            std::bidirectional_iterator_tag,
+            typename std::iterator_traits<InnerIterator>::iterator_category>::value
+        && !detail::is_random_access_iterator<InnerIterator>::value>>
+    : iterator_base<Size, InnerIterator> {
+    using inner_iterator  = InnerIterator;
+    using inner_reference = decltype(*inner_iterator{});
+
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type         = Size;
+    using value_type        = iterator_value<inner_reference, size_type>;
+    using pointer           = iterator_value<inner_reference, size_type>;
+    using reference         = iterator_value<inner_reference, size_type>;
+
+    using iterator_base<Size, InnerIterator>::iterator_base;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
+        -> reference
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
+        -> pointer
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> iterator&
+    {
+        this->_iterator++;
+        this->_index++;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept -> iterator
+    {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator--() noexcept -> iterator&
+    {
+        this->_iterator--;
+        this->_index--;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator--(int) noexcept -> iterator
+    {
+        auto tmp = *this;
+        --(*this);
+        return tmp;
+    }
+};
+
+template<typename Size, typename InnerIterator>
+struct iterator<
+    Size,
+    InnerIterator,
+    typename detail::enable_if_t<
+        detail::is_iterator<InnerIterator>::value
+        && detail::is_random_access_iterator<InnerIterator>::value>>
+    : iterator_base<Size, InnerIterator> {
+    using inner_iterator  = InnerIterator;
+    using inner_reference = decltype(*inner_iterator{});
+
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type         = Size;
+    using value_type        = iterator_value<inner_reference, size_type>;
+    using pointer           = iterator_value<inner_reference, size_type>;
+    using reference         = iterator_value<inner_reference, size_type>;
+
+    using iterator_base<Size, InnerIterator>::iterator_base;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
+        -> reference
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
+        -> pointer
+    {
+        return {this->_index, *this->_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto
+    operator[](difference_type n) const noexcept -> reference
+    {
+        return {static_cast<size_type>(this->_index + n), this->_iterator[n]};
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> iterator&
+    {
+        this->_iterator++;
+        this->_index++;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept -> iterator
+    {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator--() noexcept -> iterator&
+    {
+        this->_iterator--;
+        this->_index--;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator--(int) noexcept -> iterator
+    {
+        auto tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator+=(difference_type n) noexcept -> iterator&
+    {
+        this->_iterator += n;
+        this->_index = static_cast<size_type>(this->_index + n);
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator-=(difference_type n) noexcept -> iterator&
+    {
+        this->_iterator -= n;
+        this->_index = static_cast<size_type>(this->_index - n);
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator+(iterator it, difference_type n) noexcept -> iterator
+    {
+        return it += n;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator+(difference_type n, iterator it) noexcept -> iterator
+    {
+        return it += n;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator-(iterator it, difference_type n) noexcept -> iterator
+    {
+        return it -= n;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator-(iterator const& lhs, iterator const& rhs) noexcept -> difference_type
+    {
+        return lhs._iterator - rhs._iterator;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator<(iterator const& lhs, iterator const& rhs) noexcept -> bool
+    {
+        return lhs._iterator < rhs._iterator;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator>(iterator const& lhs, iterator const& rhs) noexcept -> bool
+    {
+        return rhs < lhs;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator<=(iterator const& lhs, iterator const& rhs) noexcept -> bool
+    {
+        return !(rhs < lhs);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator>=(iterator const& lhs, iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs < rhs);
+    }
+};
+
+template<typename Size, typename Container, typename = void>
+struct end_index_impl {
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR static auto get(Container& /*c*/) noexcept
+        -> Size
+    {
+        return static_cast<Size>(-1);
+    }
+};
+
+template<typename Size, typename Container>
+struct end_index_impl<
+    Size,
+    Container,
+    typename detail::enable_if_t<
+        detail::is_random_access_iterator<decltype(std::declval<Container&>().begin())>::value
+        && std::is_same<
+            decltype(std::declval<Container&>().begin()),
+            decltype(std::declval<Container&>().end())>::value>> {
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR static auto get(Container& c) noexcept
+        -> Size
+    {
+        return static_cast<Size>(c.end() - c.begin());
+    }
+};
+
+// NOTE: Elements reached by stepping back from the end keep their positions, so the end index of a
+// bidirectional range is its size. Only `size()` gives it in constant time, an unsized range isn't
+// walked on every `end()` and keeps the unknown end index
+
+template<typename Size, typename Container>
+struct end_index_impl<
+    Size,
+    Container,
+    typename detail::enable_if_t<
+        detail::is_bidirectional_iterator<decltype(std::declval<Container&>().begin())>::value
+        && !detail::is_random_access_iterator<decltype(std::declval<Container&>().begin())>::value
+        && std::is_same<
+            decltype(std::declval<Container&>().begin()),
+            decltype(std::declval<Container&>().end())>::value
+        && std::is_integral<decltype(std::declval<Container&>().size())>::value>> {
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR static auto get(Container& c) noexcept
+        -> Size
+    {
+        return static_cast<Size>(c.size());
+    }
+};
+
+template<typename Size, typename Container>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto end_index(Container& c) noexcept
+    -> Size
+{
+    return detail::end_index_impl<Size, Container>::get(c);
+}
+
+// NOTE: Random-access storage is walked with a counted loop over `first[i]`, so the body vectorizes
+// like a raw indexed loop. Other iterators are stepped alongside the index
+
+template<typename Size, typename Iterator, typename Sentinel, typename F>
+HIPONY_ENUMERATE_CONSTEXPR inline void
+each(std::true_type /*random_access*/, Iterator first, Sentinel last, Size max, F& f)
+{
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    auto const distance   = static_cast<Size>(last - first);
+    auto const size       = distance < max ? distance : max;
+    for (Size i = 0; i < size; ++i) {
+        f(i, first[static_cast<difference_type>(i)]);
+    }
+}
+
+template<typename Size, typename Iterator, typename Sentinel, typename F>
+HIPONY_ENUMERATE_CONSTEXPR inline void
+each(std::false_type /*random_access*/, Iterator first, Sentinel last, Size max, F& f)
+{
+    for (Size i = 0; i < max && first != last; ++first, ++i) {
+        f(i, *first);
+    }
+}
+
+template<typename Size, typename Iterator, typename Sentinel, typename F>
+HIPONY_ENUMERATE_CONSTEXPR inline void each(Iterator first, Sentinel last, Size max, F& f)
+{
+    detail::each(
+        std::integral_constant<
+            bool,
+            detail::is_random_access_iterator<Iterator>::value
+                && std::is_same<Iterator, Sentinel>::value>{},
+        static_cast<Iterator&&>(first),
+        static_cast<Sentinel&&>(last),
+        max,
+        f);
+}
+
+// NOTE: A block of 16 code units is loaded as 64-bit words and passed through in one step when it
+// holds no multi-unit sequences: ASCII bytes for UTF-8, no surrogates for UTF-16
+
+HIPONY_ENUMERATE_NODISCARD inline auto
+plain_block(std::integral_constant<std::size_t, 1> /*utf8*/, std::uint64_t word) noexcept -> bool
+{
+    return (word & 0x8080808080808080u) == 0;
+}
+
+HIPONY_ENUMERATE_NODISCARD inline auto
+plain_block(std::integral_constant<std::size_t, 2> /*utf16*/, std::uint64_t word) noexcept -> bool
+{
+    auto const lanes = (word & 0xF800F800F800F800u) ^ 0xD800D800D800D800u;
+    return ((lanes - 0x0001000100010001u) & ~lanes & 0x8000800080008000u) == 0;
+}
+
+template<typename Char>
+HIPONY_ENUMERATE_NODISCARD inline auto plain_block(Char const* ptr) noexcept -> bool
+{
+    constexpr auto words = 16 * sizeof(Char) / sizeof(std::uint64_t);
+
+    std::uint64_t block[words];
+    std::memcpy(block, ptr, sizeof(block));
+    auto merged = std::uint64_t{};
+    for (std::size_t i = 0; i < words; ++i) {
+        merged |= block[i];
+    }
+    // NOTE: OR-ing is exact for the UTF-8 high bits, surrogates need every lane checked
+    if (sizeof(Char) == 1) {
+        return detail::plain_block(std::integral_constant<std::size_t, 1>{}, merged);
+    }
+    auto plain = true;
+    for (std::size_t i = 0; i < words; ++i) {
+        plain = plain && detail::plain_block(std::integral_constant<std::size_t, 2>{}, block[i]);
+    }
+    return plain;
+}
+
+template<typename Size, typename Char, typename F>
+inline void each(code_point_iterator<Char> first, code_point_iterator<Char> last, Size max, F& f)
+{
+    using unit_type = typename std::make_unsigned<Char>::type;
+
+    auto const origin = first.base();
+    auto       ptr    = first.base();
+    auto const end    = last.base();
+    for (Size i = 0; i < max && ptr != end;) {
+        if (end - ptr >= 16 && max - i >= 16 && detail::plain_block(ptr)) {
+            auto const offset = static_cast<std::size_t>(ptr - origin);
+            for (std::size_t k = 0; k < 16; ++k) {
+                f(static_cast<Size>(i + k),
+                  code_point{offset + k, static_cast<char32_t>(static_cast<unit_type>(ptr[k]))});
+            }
+            ptr += 16;
+            i += 16;
+            continue;
+        }
+        auto       value  = char32_t{};
+        auto const length = detail::decode(ptr, end, value);
+        f(i, code_point{static_cast<std::size_t>(ptr - origin), value});
+        ptr += length;
+        ++i;
+    }
+}
+
+// NOTE: Streams are walked a whole block at a time, refilling only between the blocks
+
+template<typename Size, typename Char, typename Traits, typename F>
+inline void
+each(stream_iterator<Char, Traits> first, stream_iterator<Char, Traits> /*last*/, Size max, F& f)
+{
+    auto const blocks = first.blocks();
+    if (blocks == nullptr) {
+        return;
+    }
+    for (Size i = 0; i < max;) {
+        auto const available = static_cast<Size>(blocks->last - blocks->ptr);
+        auto const count     = available < max - i ? available : max - i;
+        auto const ptr       = blocks->ptr;
+        for (Size k = 0; k < count; ++k) {
+            f(static_cast<Size>(i + k), ptr[k]);
+        }
+        i += count;
+        blocks->ptr += count;
+        if (blocks->ptr == blocks->last && !blocks->fill()) {
+            return;
+        }
+    }
+}
+
+#if HIPONY_ENUMERATE_HAS_FILES
+
+// NOTE: Prefetched memory is walked as plain pointer loops between the prefetch triggers
+
+template<typename Size, typename T, typename F>
+inline void each(prefetch_iterator<T> first, prefetch_iterator<T> last, Size max, F& f)
+{
+    auto const state = first.get_prefetcher();
+    auto       ptr   = first.base();
+    auto const end   = last.base();
+    for (Size i = 0; i < max && ptr != end;) {
+        auto const ahead = (state->distance(ptr) + sizeof(T) - 1) / sizeof(T);
+        auto const rest  = static_cast<std::uintptr_t>(end - ptr);
+        auto const left  = static_cast<Size>(ahead > 0 && ahead < rest ? ahead : rest);
+        auto const count = left < max - i ? left : max - i;
+        for (Size k = 0; k < count; ++k) {
+            f(static_cast<Size>(i + k), ptr[k]);
+        }
+        i += count;
+        ptr += count;
+        state->touch(ptr);
+    }
+}
+
+#endif
+
+template<typename Size, typename Iterator, typename Sentinel, typename F>
+HIPONY_ENUMERATE_CONSTEXPR inline void each(Iterator first, Sentinel last, F& f)
+{
+    detail::each(
+        static_cast<Iterator&&>(first),
+        static_cast<Sentinel&&>(last),
+        (std::numeric_limits<Size>::max)(),
+        f);
+}
+
+template<typename Size, typename Container>
+struct range {
+    using value_type = typename detail::remove_rref_t<Container>;
+    using size_type  = Size;
+
+    value_type data;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> iterator<size_type, decltype(data.begin())>
+    {
+        return {data.begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> iterator<size_type, decltype(data.end())>
+    {
+        return {data.end(), detail::end_index<size_type>(data)};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> iterator<size_type, decltype(data.begin())>
+    {
+        return {data.begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> iterator<size_type, decltype(data.end())>
+    {
+        return {data.end(), detail::end_index<size_type>(data)};
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(data.begin(), data.end(), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f) const
+    {
+        detail::each<size_type>(data.begin(), data.end(), f);
+    }
+
+    // NOTE: Only available for static extents, the index is an `std::integral_constant`
+    template<
+        typename F,
+        typename Extent = detail::static_extent<detail::remove_cvref_t<value_type>>>
+    HIPONY_ENUMERATE_CONSTEXPR auto unrolled_each(F&& f) -> decltype(Extent::value, void())
+    {
+        detail::unrolled_each<size_type>(
+            data.begin(), f, detail::make_index_sequence<Extent::value>{});
+    }
+
+    template<
+        typename F,
+        typename Extent = detail::static_extent<detail::remove_cvref_t<value_type>>>
+    HIPONY_ENUMERATE_CONSTEXPR auto unrolled_each(F&& f) const -> decltype(Extent::value, void())
+    {
+        detail::unrolled_each<size_type>(
+            data.begin(), f, detail::make_index_sequence<Extent::value>{});
+    }
+};
+
+#if HIPONY_ENUMERATE_HAS_RANGES && !defined(__clang__)
+
+template<typename Size, typename Container>
+struct range_view : std::ranges::view_interface<range_view<Size, Container>> {
+    using value_type = typename detail::remove_ref_t<Container>;
+    using size_type  = Size;
+
+    value_type* data;
+
+    HIPONY_ENUMERATE_CONSTEXPR range_view() = default;
+
+    HIPONY_ENUMERATE_CONSTEXPR range_view(value_type& data_)
+        : data{&data_}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> iterator<size_type, decltype(data->begin())>
+    {
+        return {data->begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> iterator<size_type, decltype(data->end())>
+    {
+        return {data->end(), detail::end_index<size_type>(*data)};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> iterator<size_type, decltype(data->begin())>
+    {
+        return {data->begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> iterator<size_type, decltype(data->end())>
+    {
+        return {data->end(), detail::end_index<size_type>(*data)};
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(data->begin(), data->end(), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f) const
+    {
+        detail::each<size_type>(data->begin(), data->end(), f);
+    }
+
+    // NOTE: Only available for static extents, the index is an `std::integral_constant`
+    template<
+        typename F,
+        typename Extent = detail::static_extent<detail::remove_cvref_t<value_type>>>
+    HIPONY_ENUMERATE_CONSTEXPR auto unrolled_each(F&& f) -> decltype(Extent::value, void())
+    {
+        detail::unrolled_each<size_type>(
+            data->begin(), f, detail::make_index_sequence<Extent::value>{});
+    }
+
+    template<
+        typename F,
+        typename Extent = detail::static_extent<detail::remove_cvref_t<value_type>>>
+    HIPONY_ENUMERATE_CONSTEXPR auto unrolled_each(F&& f) const -> decltype(Extent::value, void())
+    {
+        detail::unrolled_each<size_type>(
+            data->begin(), f, detail::make_index_sequence<Extent::value>{});
+    }
+};
+
+template<typename Size, typename Container>
+using view = detail::range_view<Size, Container>;
+
+#else
+
+template<typename Size, typename Container>
+struct basic_view {
+    using value_type = typename detail::remove_ref_t<Container>;
+    using size_type  = Size;
+
+    value_type* data;
+
+    HIPONY_ENUMERATE_CONSTEXPR basic_view() = default;
+
+    HIPONY_ENUMERATE_CONSTEXPR basic_view(value_type& data_)
+        : data{&data_}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> iterator<size_type, decltype(data->begin())>
+    {
+        return {data->begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> iterator<size_type, decltype(data->end())>
+    {
+        return {data->end(), detail::end_index<size_type>(*data)};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> iterator<size_type, decltype(data->begin())>
+    {
+        return {data->begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> iterator<size_type, decltype(data->end())>
+    {
+        return {data->end(), detail::end_index<size_type>(*data)};
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(data->begin(), data->end(), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f) const
+    {
+        detail::each<size_type>(data->begin(), data->end(), f);
+    }
+
+    // NOTE: Only available for static extents, the index is an `std::integral_constant`
+    template<
+        typename F,
+        typename Extent = detail::static_extent<detail::remove_cvref_t<value_type>>>
+    HIPONY_ENUMERATE_CONSTEXPR auto unrolled_each(F&& f) -> decltype(Extent::value, void())
+    {
+        detail::unrolled_each<size_type>(
+            data->begin(), f, detail::make_index_sequence<Extent::value>{});
+    }
+
+    template<
+        typename F,
+        typename Extent = detail::static_extent<detail::remove_cvref_t<value_type>>>
+    HIPONY_ENUMERATE_CONSTEXPR auto unrolled_each(F&& f) const -> decltype(Extent::value, void())
+    {
+        detail::unrolled_each<size_type>(
+            data->begin(), f, detail::make_index_sequence<Extent::value>{});
+    }
+};
+
+template<typename Size, typename Container>
+using view = detail::basic_view<Size, Container>;
+
+#endif
+
+template<typename Size, typename InnerIterator, typename = void>
+class limited_iterator {
+public:
+    using inner_iterator  = InnerIterator;
+    using inner_reference = decltype(*inner_iterator{});
+
+    using iterator_category = typename std::iterator_traits<inner_iterator>::iterator_category;
+    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type         = Size;
+    using value_type        = iterator_value<inner_reference, size_type>;
+    using pointer           = iterator_value<inner_reference, size_type>;
+    using reference         = iterator_value<inner_reference, size_type>;
+
+private:
+    size_type      _max;
+    size_type      _index;
+    inner_iterator _iterator;
+
+public:
+    HIPONY_ENUMERATE_CONSTEXPR limited_iterator() = default;
+
+    HIPONY_ENUMERATE_CONSTEXPR limited_iterator(size_type max, inner_iterator iterator)
+        : _max{max}
+        , _index{0}
+        , _iterator{static_cast<inner_iterator&&>(iterator)}
+    {}
+
+    HIPONY_ENUMERATE_CONSTEXPR
+    limited_iterator(size_type max, size_type index, inner_iterator iterator)
+        : _max{max}
+        , _index{index}
+        , _iterator{static_cast<inner_iterator&&>(iterator)}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
+        -> reference
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
+        -> pointer
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> limited_iterator&
+    {
+        _iterator++;
+        _index++;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept -> limited_iterator
+    {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator==(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._index == rhs._index || lhs._iterator == rhs._iterator;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator!=(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
+
+template<typename Size, typename InnerIterator>
+class limited_iterator<
+    Size,
+    InnerIterator,
+    typename detail::enable_if_t<
+        std::is_base_of<
+            std::bidirectional_iterator_tag,
+            typename std::iterator_traits<InnerIterator>::iterator_category>::value
+        && !detail::is_random_access_iterator<InnerIterator>::value>> {
+public:
+    using inner_iterator  = InnerIterator;
+    using inner_reference = decltype(*inner_iterator{});
+
+    using iterator_category = typename std::iterator_traits<inner_iterator>::iterator_category;
+    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type         = Size;
+    using value_type        = iterator_value<inner_reference, size_type>;
+    using pointer           = iterator_value<inner_reference, size_type>;
+    using reference         = iterator_value<inner_reference, size_type>;
+
+private:
+    size_type      _max;
+    size_type      _index;
+    inner_iterator _iterator;
+
+public:
+    HIPONY_ENUMERATE_CONSTEXPR limited_iterator() = default;
+
+    HIPONY_ENUMERATE_CONSTEXPR limited_iterator(size_type max, inner_iterator iterator)
+        : _max{max}
+        , _index{0}
+        , _iterator{static_cast<inner_iterator&&>(iterator)}
+    {}
+
+    HIPONY_ENUMERATE_CONSTEXPR
+    limited_iterator(size_type max, size_type index, inner_iterator iterator)
+        : _max{max}
+        , _index{index}
+        , _iterator{static_cast<inner_iterator&&>(iterator)}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
+        -> reference
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
+        -> pointer
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> limited_iterator&
+    {
+        _iterator++;
+        _index++;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept -> limited_iterator
+    {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator--() noexcept -> limited_iterator&
+    {
+        _iterator--;
+        _index--;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator--(int) noexcept -> limited_iterator
+    {
+        auto tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator==(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._index == rhs._index || lhs._iterator == rhs._iterator;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator!=(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
+
+template<typename Size, typename InnerIterator>
+class limited_iterator<
+    Size,
+    InnerIterator,
+    typename detail::enable_if_t<detail::is_random_access_iterator<InnerIterator>::value>> {
+public:
+    using inner_iterator  = InnerIterator;
+    using inner_reference = decltype(*inner_iterator{});
+
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type         = Size;
+    using value_type        = iterator_value<inner_reference, size_type>;
+    using pointer           = iterator_value<inner_reference, size_type>;
+    using reference         = iterator_value<inner_reference, size_type>;
+
+private:
+    size_type      _max;
+    size_type      _index;
+    inner_iterator _iterator;
+
+public:
+    HIPONY_ENUMERATE_CONSTEXPR limited_iterator() = default;
+
+    HIPONY_ENUMERATE_CONSTEXPR limited_iterator(size_type max, inner_iterator iterator)
+        : _max{max}
+        , _index{0}
+        , _iterator{static_cast<inner_iterator&&>(iterator)}
+    {}
+
+    HIPONY_ENUMERATE_CONSTEXPR
+    limited_iterator(size_type max, size_type index, inner_iterator iterator)
+        : _max{max}
+        , _index{index}
+        , _iterator{static_cast<inner_iterator&&>(iterator)}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() noexcept -> reference
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator*() const noexcept
+        -> reference
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() noexcept -> pointer
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto operator->() const noexcept
+        -> pointer
+    {
+        return {_index, *_iterator};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto
+    operator[](difference_type n) const noexcept -> reference
+    {
+        return {static_cast<size_type>(_index + n), _iterator[n]};
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator++() noexcept -> limited_iterator&
+    {
+        _iterator++;
+        _index++;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator++(int) noexcept -> limited_iterator
+    {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator--() noexcept -> limited_iterator&
+    {
+        _iterator--;
+        _index--;
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator--(int) noexcept -> limited_iterator
+    {
+        auto tmp = *this;
+        --(*this);
+        return tmp;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator+=(difference_type n) noexcept -> limited_iterator&
+    {
+        _iterator += n;
+        _index = static_cast<size_type>(_index + n);
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_CONSTEXPR auto operator-=(difference_type n) noexcept -> limited_iterator&
+    {
+        _iterator -= n;
+        _index = static_cast<size_type>(_index - n);
+        return *this;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator+(limited_iterator it, difference_type n) noexcept -> limited_iterator
+    {
+        return it += n;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator+(difference_type n, limited_iterator it) noexcept -> limited_iterator
+    {
+        return it += n;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator-(limited_iterator it, difference_type n) noexcept -> limited_iterator
+    {
+        return it -= n;
+    }
+
+    // NOTE: The end iterator is clamped by `limited_end`, so indices stay in sync with positions
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator-(limited_iterator const& lhs, limited_iterator const& rhs) noexcept
+        -> difference_type
+    {
+        return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator==(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._index == rhs._index || lhs._iterator == rhs._iterator;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator!=(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator<(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._index < rhs._index;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator>(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return rhs < lhs;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator<=(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return !(rhs < lhs);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend HIPONY_ENUMERATE_CONSTEXPR auto
+    operator>=(limited_iterator const& lhs, limited_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs < rhs);
+    }
+};
+
+template<typename Size, typename Container, typename = void>
+struct limited_end_impl {
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR static auto
+    get(Size max, Container& c) noexcept -> limited_iterator<Size, decltype(c.end())>
+    {
+        return {max, max, c.end()};
+    }
+};
+
+template<typename Size, typename Container>
+struct limited_end_impl<
+    Size,
+    Container,
+    typename detail::enable_if_t<
+        detail::is_random_access_iterator<decltype(std::declval<Container&>().begin())>::value
+        && std::is_same<
+            decltype(std::declval<Container&>().begin()),
+            decltype(std::declval<Container&>().end())>::value>> {
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR static auto
+    get(Size max, Container& c) noexcept -> limited_iterator<Size, decltype(c.end())>
+    {
+        return {
+            max,
+            static_cast<Size>(c.end() - c.begin()) < max ? static_cast<Size>(c.end() - c.begin())
+                                                         : max,
+            static_cast<Size>(c.end() - c.begin()) < max
+                ? c.end()
+                : c.begin()
+                      + static_cast<
+                          typename std::iterator_traits<decltype(c.begin())>::difference_type>(
+                          max)};
+    }
+};
+
+template<typename Size, typename Container>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
+limited_end(Size max, Container& c) noexcept -> limited_iterator<Size, decltype(c.end())>
+{
+    return detail::limited_end_impl<Size, Container>::get(max, c);
+}
+
+template<typename Size, typename Container, typename = void>
+struct limited_range {
+    using value_type = typename detail::remove_rref_t<Container>;
+    using size_type  = Size;
+
+    struct impl_t {
+        value_type data;
+        size_type  size;
+
+        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
+        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type&& data_, size_type size_)
+            : data{static_cast<decltype(data_)&&>(data_)}
+            , size{size_}
+        {}
+    } impl;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> limited_iterator<size_type, decltype(impl.data.begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {impl.size, impl.data.begin()};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> limited_iterator<size_type, decltype(impl.data.end())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return detail::limited_end(impl.size, impl.data);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> limited_iterator<size_type, decltype(impl.data.begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {impl.size, impl.data.begin()};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> limited_iterator<size_type, decltype(impl.data.end())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return detail::limited_end(impl.size, impl.data);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(
+            impl.data.begin(), impl.data.end(), static_cast<size_type>(impl.size), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f) const
+    {
+        detail::each<size_type>(
+            impl.data.begin(), impl.data.end(), static_cast<size_type>(impl.size), f);
+    }
+};
+
+template<typename Size, typename Container>
+struct limited_range<
+    Size,
+    Container,
+    typename detail::enable_if_t<
+        detail::is_sized_range<detail::remove_cvref_t<Container>>::value
+        && detail::is_random_access_range<detail::remove_cvref_t<Container>>::value>> {
+    using value_type      = typename detail::remove_rref_t<Container>;
+    using inner_iterator  = typename detail::remove_cvref_t<Container>::iterator;
+    using difference_type = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type       = Size;
+
+    struct impl_t {
+        value_type      data;
+        difference_type size;
+
+        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
+        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type&& data_, size_type size_)
+            : data{static_cast<decltype(data_)&&>(data_)}
+            , size{
+                  static_cast<difference_type>(size_) < static_cast<difference_type>(data.size())
+                      ? static_cast<difference_type>(size_)
+                      : static_cast<difference_type>(data.size())}
+        {}
+    } impl;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> iterator<size_type, decltype(impl.data.begin())>
+    {
+        return {impl.data.begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> iterator<size_type, decltype(impl.data.begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {
+            impl.data.begin() + static_cast<difference_type>(impl.size),
+            static_cast<size_type>(impl.size)};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> iterator<size_type, decltype(impl.data.begin())>
+    {
+        return {impl.data.begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> iterator<size_type, decltype(impl.data.begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {
+            impl.data.begin() + static_cast<difference_type>(impl.size),
+            static_cast<size_type>(impl.size)};
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(
+            impl.data.begin(), impl.data.end(), static_cast<size_type>(impl.size), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f) const
+    {
+        detail::each<size_type>(
+            impl.data.begin(), impl.data.end(), static_cast<size_type>(impl.size), f);
+    }
+};
+
+#if HIPONY_ENUMERATE_HAS_RANGES && !defined(__clang__)
+
+template<typename Size, typename Container, typename = void>
+struct limited_range_view : std::ranges::view_interface<limited_range_view<Size, Container>> {
+    using value_type = typename detail::remove_ref_t<Container>;
+    using size_type  = Size;
+
+    struct impl_t {
+        value_type* data;
+        size_type   size;
+
+        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
+        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type& data_, size_type size_)
+            : data{&data_}
+            , size{size_}
+        {}
+    } impl;
+
+    HIPONY_ENUMERATE_CONSTEXPR limited_range_view() = default;
+
+    HIPONY_ENUMERATE_CONSTEXPR limited_range_view(impl_t impl_)
+        : impl{static_cast<impl_t&&>(impl_)}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> limited_iterator<size_type, decltype(impl.data->begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {impl.size, impl.data->begin()};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> limited_iterator<size_type, decltype(impl.data->end())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return detail::limited_end(impl.size, *impl.data);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> limited_iterator<size_type, decltype(impl.data->begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {impl.size, impl.data->begin()};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> limited_iterator<size_type, decltype(impl.data->end())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return detail::limited_end(impl.size, *impl.data);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(
+            impl.data->begin(), impl.data->end(), static_cast<size_type>(impl.size), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f) const
+    {
+        detail::each<size_type>(
+            impl.data->begin(), impl.data->end(), static_cast<size_type>(impl.size), f);
+    }
+};
+
+template<typename Size, typename Container>
+struct limited_range_view<
+    Size,
+    Container,
+    typename detail::enable_if_t<
+        detail::is_sized_range<detail::remove_cvref_t<Container>>::value
+        && detail::is_random_access_range<detail::remove_cvref_t<Container>>::value>>
+    : std::ranges::view_interface<limited_range_view<Size, Container>> {
+    using value_type      = typename detail::remove_rref_t<Container>;
+    using inner_iterator  = typename detail::remove_cvref_t<Container>::iterator;
+    using difference_type = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type       = Size;
+
+    struct impl_t {
+        value_type*     data;
+        difference_type size;
+
+        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
+        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type& data_, size_type size_)
+            : data{&data_}
+            , size{
+                  static_cast<difference_type>(size_) < static_cast<difference_type>(data->size())
+                      ? static_cast<difference_type>(size_)
+                      : static_cast<difference_type>(data->size())}
+        {}
+    } impl;
+
+    HIPONY_ENUMERATE_CONSTEXPR limited_range_view() = default;
+
+    HIPONY_ENUMERATE_CONSTEXPR limited_range_view(impl_t impl_)
+        : impl{static_cast<impl_t&&>(impl_)}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> iterator<size_type, decltype(impl.data->begin())>
+    {
+        return {impl.data->begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> iterator<size_type, decltype(impl.data->begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {
+            impl.data->begin() + static_cast<difference_type>(impl.size),
+            static_cast<size_type>(impl.size)};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> iterator<size_type, decltype(impl.data->begin())>
+    {
+        return {impl.data->begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> iterator<size_type, decltype(impl.data->begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {
+            impl.data->begin() + static_cast<difference_type>(impl.size),
+            static_cast<size_type>(impl.size)};
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(
+            impl.data->begin(), impl.data->end(), static_cast<size_type>(impl.size), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f) const
+    {
+        detail::each<size_type>(
+            impl.data->begin(), impl.data->end(), static_cast<size_type>(impl.size), f);
+    }
+};
+
+template<typename Size, typename Container>
+using limited_view = detail::limited_range_view<Size, Container>;
+
+#else
+
+template<typename Size, typename Container, typename = void>
+struct limited_basic_view {
+    using value_type = typename detail::remove_ref_t<Container>;
+    using size_type  = Size;
+
+    struct impl_t {
+        value_type* data;
+        size_type   size;
+
+        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
+        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type& data_, size_type size_)
+            : data{&data_}
+            , size{size_}
+        {}
+    } impl;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> limited_iterator<size_type, decltype(impl.data->begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {impl.size, impl.data->begin()};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> limited_iterator<size_type, decltype(impl.data->end())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return detail::limited_end(impl.size, *impl.data);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> limited_iterator<size_type, decltype(impl.data->begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {impl.size, impl.data->begin()};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> limited_iterator<size_type, decltype(impl.data->end())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return detail::limited_end(impl.size, *impl.data);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(
+            impl.data->begin(), impl.data->end(), static_cast<size_type>(impl.size), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f) const
+    {
+        detail::each<size_type>(
+            impl.data->begin(), impl.data->end(), static_cast<size_type>(impl.size), f);
+    }
+};
+
+template<typename Size, typename Container>
+struct limited_basic_view<
+    Size,
+    Container,
+    typename detail::enable_if_t<
+        detail::is_sized_range<detail::remove_cvref_t<Container>>::value
+        && detail::is_random_access_range<detail::remove_cvref_t<Container>>::value>> {
+    using value_type      = typename detail::remove_rref_t<Container>;
+    using inner_iterator  = typename detail::remove_cvref_t<Container>::iterator;
+    using difference_type = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type       = Size;
+
+    struct impl_t {
+        value_type*     data;
+        difference_type size;
+
+        HIPONY_ENUMERATE_CONSTEXPR impl_t() = default;
+        HIPONY_ENUMERATE_CONSTEXPR impl_t(value_type& data_, size_type size_)
+            : data{&data_}
+            , size{
+                  static_cast<difference_type>(size_) < static_cast<difference_type>(data->size())
+                      ? static_cast<difference_type>(size_)
+                      : static_cast<difference_type>(data->size())}
+        {}
+    } impl;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> iterator<size_type, decltype(impl.data->begin())>
+    {
+        return {impl.data->begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> iterator<size_type, decltype(impl.data->begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {
+            impl.data->begin() + static_cast<difference_type>(impl.size),
+            static_cast<size_type>(impl.size)};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> iterator<size_type, decltype(impl.data->begin())>
+    {
+        return {impl.data->begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> iterator<size_type, decltype(impl.data->begin())>
+    {
+        assert(impl.size >= 0 && "Size is negative");
+        return {
+            impl.data->begin() + static_cast<difference_type>(impl.size),
+            static_cast<size_type>(impl.size)};
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(
+            impl.data->begin(), impl.data->end(), static_cast<size_type>(impl.size), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f) const
+    {
+        detail::each<size_type>(
+            impl.data->begin(), impl.data->end(), static_cast<size_type>(impl.size), f);
+    }
+};
+
+template<typename Size, typename Container>
+using limited_view = detail::limited_basic_view<Size, Container>;
+
+#endif
+
+template<typename T>
+struct is_borrowed_range : std::false_type {};
+
+template<typename Size, typename Container>
+struct is_borrowed_range<detail::view<Size, Container>> : std::true_type {};
+
+template<typename Size, typename Container>
+struct is_borrowed_range<detail::limited_view<Size, Container>> : std::true_type {};
+
+template<typename Size, typename It, typename Sentinel, typename SpanSize, SpanSize N>
+struct is_borrowed_range<detail::range<Size, detail::span<It, Sentinel, SpanSize, N>>>
+    : std::true_type {};
+
+template<typename Size, typename Char>
+struct is_borrowed_range<detail::range<Size, detail::zstring_view<Char>>> : std::true_type {};
+
+template<typename Size, typename T, std::size_t N>
+struct is_borrowed_range<detail::range<Size, detail::reference_array<T, N>>> : std::true_type {};
+
+#if HIPONY_ENUMERATE_HAS_STRING_VIEW
+
+template<typename Size>
+struct is_borrowed_range<detail::range<Size, detail::lines<std::string_view>>> : std::true_type {};
+
+template<typename Size>
+struct is_borrowed_range<detail::range<Size, detail::indexed_lines<std::string_view>>>
+    : std::true_type {};
+
+template<typename Size>
+struct is_borrowed_range<detail::range<Size, detail::csv_view>> : std::true_type {};
+
+#endif
+
+template<typename Iterator>
+struct subrange {
+    using iterator        = Iterator;
+    using const_iterator  = Iterator;
+    using difference_type = typename std::iterator_traits<iterator>::difference_type;
+
+    iterator _begin;
+    iterator _end;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> const_iterator
+    {
+        return _begin;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> const_iterator
+    {
+        return _end;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> difference_type
+    {
+        return std::distance(_begin, _end);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto empty() const noexcept -> bool
+    {
+        return _begin == _end;
+    }
+};
+
+template<typename Difference, typename Split>
+HIPONY_ENUMERATE_NODISCARD inline auto split_size(Difference size, Split const& split, int) noexcept
+    -> decltype(split.left(), split.right(), Difference{})
+{
+    auto const left  = static_cast<double>(split.left());
+    auto const right = static_cast<double>(split.right());
+    auto const value = static_cast<Difference>(static_cast<double>(size) * left / (left + right));
+    return (std::max)(Difference{1}, (std::min)(value, size - 1));
+}
+
+template<typename Difference, typename Split>
+HIPONY_ENUMERATE_NODISCARD inline auto
+split_size(Difference size, Split const& /*split*/, long) noexcept -> Difference
+{
+    return size / 2;
+}
+
+// NOTE: Models the TBB Range concept. The splitting constructor accepts any split tag and honours
+// `left()`/`right()` proportions when the tag provides them
+
+template<typename Iterator>
+class blocked_range {
+public:
+    using iterator        = Iterator;
+    using const_iterator  = Iterator;
+    using difference_type = typename std::iterator_traits<iterator>::difference_type;
+    using size_type       = difference_type;
+
+private:
+    iterator        _begin;
+    iterator        _end;
+    difference_type _grain;
+
+public:
+    blocked_range(iterator begin, iterator end, difference_type grain = 1)
+        : _begin{static_cast<iterator&&>(begin)}
+        , _end{static_cast<iterator&&>(end)}
+        , _grain{grain}
+    {
+        assert(grain > 0 && "Grain should be positive");
+    }
+
+    template<typename Split>
+    blocked_range(blocked_range& other, Split const& split)
+        : _begin{std::next(other._begin, detail::split_size(other.size(), split, 0))}
+        , _end{other._end}
+        , _grain{other._grain}
+    {
+        other._end = _begin;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto begin() const noexcept -> const_iterator
+    {
+        return _begin;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
+    {
+        return _end;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> size_type
+    {
+        return std::distance(_begin, _end);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto grainsize() const noexcept -> size_type
+    {
+        return _grain;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto empty() const noexcept -> bool
+    {
+        return _begin == _end;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto is_divisible() const noexcept -> bool
+    {
+        return _grain < size();
+    }
+};
+
+// NOTE: Chunk `i` starts at `i * step + min(i, remainder)`, which covers both even splits into
+// a fixed number of chunks and fixed-size chunks with a shorter tail
+
+template<typename Iterator>
+class chunk_view {
+public:
+    using inner_iterator  = Iterator;
+    using difference_type = typename std::iterator_traits<inner_iterator>::difference_type;
+    using size_type       = difference_type;
+    using value_type      = detail::subrange<inner_iterator>;
+    using reference       = value_type;
+
+private:
+    inner_iterator  _begin;
+    difference_type _size;
+    difference_type _count;
+    difference_type _step;
+    difference_type _remainder;
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type   = typename chunk_view::difference_type;
+        using value_type        = typename chunk_view::value_type;
+        using pointer           = value_type;
+        using reference         = value_type;
+
+    private:
+        chunk_view const* _view;
+        difference_type   _index;
+        inner_iterator    _first;
+
+    public:
+        iterator() = default;
+
+        iterator(chunk_view const* view, difference_type index, inner_iterator first)
+            : _view{view}
+            , _index{index}
+            , _first{static_cast<inner_iterator&&>(first)}
+        {}
+
+        HIPONY_ENUMERATE_NODISCARD auto operator*() const -> reference
+        {
+            return {_first, std::next(_first, _view->length(_index))};
+        }
+
+        auto operator++() -> iterator&
+        {
+            std::advance(_first, _view->length(_index));
+            ++_index;
+            return *this;
+        }
+
+        HIPONY_ENUMERATE_NODISCARD auto operator++(int) -> iterator
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        HIPONY_ENUMERATE_NODISCARD friend auto
+        operator==(iterator const& lhs, iterator const& rhs) noexcept -> bool
+        {
+            return lhs._index == rhs._index;
+        }
+
+        HIPONY_ENUMERATE_NODISCARD friend auto
+        operator!=(iterator const& lhs, iterator const& rhs) noexcept -> bool
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    using const_iterator = iterator;
+
+    chunk_view(
+        inner_iterator  begin,
+        difference_type size,
+        difference_type count,
+        difference_type step,
+        difference_type remainder)
+        : _begin{static_cast<inner_iterator&&>(begin)}
+        , _size{size}
+        , _count{count}
+        , _step{step}
+        , _remainder{remainder}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD auto begin() const -> const_iterator
+    {
+        return {this, 0, _begin};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto end() const -> const_iterator
+    {
+        return {this, _count, _begin};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> size_type
+    {
+        return _count;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator[](difference_type index) const -> reference
+    {
+        assert(index >= 0 && index < _count && "Index is out of range");
+        return {std::next(_begin, offset(index)), std::next(_begin, offset(index + 1))};
+    }
+
+private:
+    HIPONY_ENUMERATE_NODISCARD auto offset(difference_type index) const noexcept
+        -> difference_type
+    {
+        return (std::min)(
+            _size, index * _step + (index < _remainder ? index : _remainder));
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto length(difference_type index) const noexcept
+        -> difference_type
+    {
+        return offset(index + 1) - offset(index);
+    }
+};
+
+template<typename Range>
+using range_iterator_t = decltype(std::declval<Range&>().begin());
+
+template<typename Range>
+using is_common_range = std::
+    is_same<detail::range_iterator_t<Range>, decltype(std::declval<Range&>().end())>;
+
+template<typename Range>
+inline auto common_end(Range& range, std::true_type /*common*/) -> detail::range_iterator_t<Range>
+{
+    return range.end();
+}
+
+// NOTE: Sentinel-terminated ranges, like C-Strings in C++20, are walked once to reach the end
+template<typename Range>
+inline auto common_end(Range& range, std::false_type /*common*/)
+    -> detail::range_iterator_t<Range>
+{
+    auto       it   = range.begin();
+    auto const last = range.end();
+    while (it != last) {
+        ++it;
+    }
+    return it;
+}
+
+template<typename Range>
+inline auto common_end(Range& range) -> detail::range_iterator_t<Range>
+{
+    return detail::common_end(range, detail::is_common_range<Range>{});
+}
+
+template<typename Range, typename = void>
+struct is_random_access_enumerate : std::false_type {};
+
+template<typename Range>
+struct is_random_access_enumerate<
+    Range,
+    typename detail::enable_if_t<
+        detail::is_random_access_iterator<decltype(std::declval<Range&>().begin())>::value
+        && std::is_same<
+            decltype(std::declval<Range&>().begin()),
+            decltype(std::declval<Range&>().end())>::value>> : std::true_type {};
+
+template<typename Range>
+struct splittable {
+    static_assert(
+        std::is_lvalue_reference<Range>::value
+            || detail::is_borrowed_range<detail::remove_cvref_t<Range>>::value,
+        "Chunks would outlive the enumerated container. Enumerate an lvalue instead.");
+
+    using type            = detail::chunk_view<detail::range_iterator_t<Range>>;
+    using blocked_type    = detail::blocked_range<detail::range_iterator_t<Range>>;
+    using difference_type = typename type::difference_type;
+};
+
+template<typename Size, typename T, typename U = T>
+struct tuple_wrapper;
+
+template<typename Size, typename T, template<typename...> class Tuple, typename... Ts>
+struct tuple_wrapper<Size, T, Tuple<Ts...>> {
+    using tuple_type = typename detail::remove_rref_t<T>;
+    using size_type  = Size;
+
+    tuple_type data;
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        do_each(f, detail::make_index_sequence<sizeof...(Ts)>{});
+    }
+
+    // NOTE: Stops at the first element for which `f` returns true and reports whether it did
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR auto each_until(F&& f) -> bool
+    {
+        return do_each_until(f, detail::make_index_sequence<sizeof...(Ts)>{});
+    }
+
+    template<typename F>
+    using visit_result_t = decltype(std::declval<F&>()(
+        std::declval<size_type>(), std::get<0>(std::declval<tuple_type&>())));
+
+    // NOTE: Dispatches through a table of function pointers, every call has to return the same type
+    template<typename F>
+    auto visit_at(size_type index, F&& f) -> visit_result_t<F>
+    {
+        assert(static_cast<std::size_t>(index) < sizeof...(Ts) && "Index is out of range");
+        return do_visit_at(index, f, detail::make_index_sequence<sizeof...(Ts)>{});
+    }
+
+private:
+    template<std::size_t I, typename F>
+    static auto visit_one(tuple_wrapper& self, F& f) -> visit_result_t<F>
+    {
+        return f(static_cast<size_type>(I), std::get<I>(self.data));
+    }
+
+    template<typename F, std::size_t... Is>
+    auto do_visit_at(size_type index, F& f, detail::index_sequence<Is...> /*indices*/)
+        -> visit_result_t<F>
+    {
+        using function = visit_result_t<F> (*)(tuple_wrapper&, F&);
+        static constexpr function const table[] = {&tuple_wrapper::visit_one<Is, F>...};
+        return table[static_cast<std::size_t>(index)](*this, f);
+    }
+
+    template<typename F, std::size_t... Is>
+    HIPONY_ENUMERATE_CONSTEXPR void do_each(F& f, detail::index_sequence<Is...> /*indices*/)
+    {
+        using swallow = int[];
+        static_cast<void>(swallow{
+            0, (static_cast<void>(f(static_cast<size_type>(Is), std::get<Is>(data))), 0)...});
+    }
+
+    template<typename F, std::size_t... Is>
+    HIPONY_ENUMERATE_CONSTEXPR auto do_each_until(F& f, detail::index_sequence<Is...> /*indices*/)
+        -> bool
+    {
+        using swallow = int[];
+        auto found    = false;
+        static_cast<void>(swallow{
+            0,
+            (static_cast<void>(
+                 found = found || f(static_cast<size_type>(Is), std::get<Is>(data))),
+             0)...});
+        return found;
+    }
+};
+
+// NOTE: Same-typed values are stored contiguously, so they enumerate like an array while keeping
+// the callback interface of `tuple_wrapper`. Lvalues are held by address instead
+
+template<typename Size, typename T, std::size_t N>
+struct homogeneous_tuple_wrapper {
+    using value_type = detail::conditional_t<
+        std::is_reference<T>::value,
+        detail::reference_array<detail::remove_ref_t<T>, N>,
+        detail::array<T, static_cast<std::ptrdiff_t>(N)>>;
+    using size_type  = Size;
+
+    value_type data;
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() noexcept
+        -> iterator<size_type, decltype(data.begin())>
+    {
+        return {data.begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() noexcept
+        -> iterator<size_type, decltype(data.end())>
+    {
+        return {data.end(), static_cast<size_type>(N)};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto begin() const noexcept
+        -> iterator<size_type, decltype(data.begin())>
+    {
+        return {data.begin(), 0};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR auto end() const noexcept
+        -> iterator<size_type, decltype(data.end())>
+    {
+        return {data.end(), static_cast<size_type>(N)};
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        detail::each<size_type>(data.begin(), data.end(), f);
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR auto each_until(F&& f) -> bool
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (f(static_cast<size_type>(i), data.begin()[static_cast<std::ptrdiff_t>(i)])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename F>
+    auto visit_at(size_type index, F&& f) -> decltype(f(index, std::declval<T&>()))
+    {
+        assert(static_cast<std::size_t>(index) < N && "Index is out of range");
+        return f(index, data.begin()[static_cast<std::ptrdiff_t>(index)]);
+    }
+};
+
+template<typename T, typename... Ts>
+struct all_same : detail::all_of<std::is_same<T, Ts>::value...> {};
+
+#if HIPONY_ENUMERATE_HAS_AGGREGATES
+
+template<typename Size, typename T>
+struct aggregate_wrapper {
+    using aggregate_type = typename detail::remove_rref_t<T>;
+    using size_type      = Size;
+
+    aggregate_type data;
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR void each(F&& f)
+    {
+        using tuple_type = decltype(boost::pfr::structure_tie(data));
+        detail::tuple_wrapper<
+            Size,
+            detail::remove_rref_t<tuple_type>,
+            detail::remove_cvref_t<tuple_type>>{boost::pfr::structure_tie(data)}
+            .each(static_cast<F&&>(f));
+    }
+
+    template<typename F>
+    HIPONY_ENUMERATE_CONSTEXPR auto each_until(F&& f) -> bool
+    {
+        using tuple_type = decltype(boost::pfr::structure_tie(data));
+        return detail::tuple_wrapper<
+                   Size,
+                   detail::remove_rref_t<tuple_type>,
+                   detail::remove_cvref_t<tuple_type>>{boost::pfr::structure_tie(data)}
+            .each_until(static_cast<F&&>(f));
+    }
+
+    template<typename F>
+    auto visit_at(Size index, F&& f) -> decltype(auto)
+    {
+        using tuple_type = decltype(boost::pfr::structure_tie(data));
+        return detail::tuple_wrapper<
+                   Size,
+                   detail::remove_rref_t<tuple_type>,
+                   detail::remove_cvref_t<tuple_type>>{boost::pfr::structure_tie(data)}
+            .visit_at(index, static_cast<F&&>(f));
+    }
+};
+
+#endif
+
+struct variadic_tuple_tag_t {};
+struct variadic_array_tag_t {};
+struct iterator_pointer_tag_t {};
+struct iterator_tag_t {};
+struct container_tag_t {};
+struct container_size_tag_t {};
+struct tuple_tag_t {};
+struct pointer_tag_t {};
+struct string_tag_t {};
+struct array_tag_t {};
+
+#if HIPONY_ENUMERATE_HAS_AGGREGATES
+struct aggregate_tag_t {};
+#endif
+
+template<typename Size, typename T, typename = void, typename...>
+struct tag;
+
+template<typename Size, typename T, typename T1>
+struct tag<
+    Size,
+    T,
+    typename detail::enable_if_t<
+        std::is_same<T, T1>::value && detail::is_iterator<T>::value && std::is_pointer<T>::value>,
+    T1> {
+    using type = iterator_pointer_tag_t;
+};
+
+template<typename Size, typename T, typename Sentinel>
+struct tag<
+    Size,
+    T,
+    typename detail::enable_if_t<
+        detail::sentinel_for<Sentinel, T>::value && detail::is_iterator<T>::value
+        && (!std::is_pointer<T>::value || !std::is_pointer<Sentinel>::value)>,
+    Sentinel> {
+    using type = iterator_tag_t;
+};
+
+template<typename Size, typename T>
+struct tag<
+    Size,
+    T,
+    typename detail::enable_if_t<!std::is_array<T>::value && detail::is_range<T>::value>> {
+    using type = container_tag_t;
+};
+
+template<typename Size, typename T, typename TSize>
+struct tag<
+    Size,
+    T,
+    typename detail::enable_if_t<
+        !std::is_array<T>::value && detail::is_range<T>::value && std::is_integral<Size>::value
+        && std::is_convertible<TSize, Size>::value>,
+    TSize> {
+    static_assert(
+        !detail::is_narrow_convertible<TSize, Size>::value,
+        "Narrowing conversions for Size are not allowed. Either cast it explicitly or use the "
+        "`_as<Size>` overload.");
+    using type = container_size_tag_t;
+};
+
+template<typename Size, typename T>
+struct tag<
+    Size,
+    T,
+    typename detail::enable_if_t<
+        detail::is_tuple<detail::decay_t<T>>::value && !detail::is_range<T>::value>> {
+    using type = tuple_tag_t;
+};
+
+template<typename Size, typename T, typename TSize>
+struct tag<
+    Size,
+    T*,
+    typename detail::enable_if_t<
+        std::is_integral<Size>::value && std::is_convertible<TSize, Size>::value>,
+    TSize> {
+    static_assert(
+        !detail::is_narrow_convertible<TSize, Size>::value,
+        "Narrowing conversions for Size are not allowed. Either cast it explicitly or use the "
+        "`_as<Size>` overload.");
+    using type = pointer_tag_t;
+};
+
+template<typename Size>
+struct tag<Size, char const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+template<typename Size>
+struct tag<Size, wchar_t const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+#if HIPONY_ENUMERATE_HAS_CHAR8
+
+template<typename Size>
+struct tag<Size, char8_t const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+#endif
+
+template<typename Size>
+struct tag<Size, char16_t const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+template<typename Size>
+struct tag<Size, char32_t const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+template<typename Size, Size N>
+struct tag<Size, char const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+template<typename Size, Size N>
+struct tag<Size, wchar_t const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+#if HIPONY_ENUMERATE_HAS_CHAR8
+
+template<typename Size, Size N>
+struct tag<Size, char8_t const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+#endif
+
+template<typename Size, Size N>
+struct tag<Size, char16_t const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+template<typename Size, Size N>
+struct tag<Size, char32_t const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
+    using type = string_tag_t;
+};
+
+template<typename Size, typename T, Size N>
+struct tag<
+    Size,
+    T[N],
+    typename detail::enable_if_t<
+        std::is_integral<Size>::value && !detail::is_string_literal<T>::value>> {
+    using type = array_tag_t;
+};
+
+template<typename Size, typename T, Size N, typename TSize>
+struct tag<
+    Size,
+    T[N],
+    typename detail::enable_if_t<
+        std::is_integral<Size>::value && std::is_convertible<TSize, Size>::value>,
+    TSize> {
+    static_assert(
+        !detail::is_narrow_convertible<TSize, Size>::value,
+        "Narrowing conversions for Size are not allowed. Either cast it explicitly or use the "
+        "`_as<Size>` overload.");
+    using type = array_tag_t;
+};
+
+#if HIPONY_ENUMERATE_HAS_AGGREGATES
+
+template<typename Size, typename T>
+struct tag<
+    Size,
+    T,
+    typename detail::enable_if_t<
+        std::is_aggregate<T>::value && !std::is_polymorphic<T>::value && !detail::is_tuple<T>::value
+        && !std::is_array<T>::value>> {
+    using type = aggregate_tag_t;
+};
+
+#endif
+
+template<typename... Ts>
+using tag_t = typename tag<Ts...>::type;
+
+template<typename Tag = void, typename...>
+struct dispatch;
+
+template<typename Size, typename T, typename... Ts>
+struct dispatch<detail::variadic_tuple_tag_t, Size, T, Ts...> {
+    using type = detail::conditional_t<
+        detail::all_same<detail::remove_rref_t<T>, detail::remove_rref_t<Ts>...>::value,
+        detail::homogeneous_tuple_wrapper<Size, detail::remove_rref_t<T>, sizeof...(Ts) + 1>,
+        detail::tuple_wrapper<
+            Size,
+            std::tuple<detail::remove_rref_t<T>, detail::remove_rref_t<Ts>...>>>;
+};
+
+// NOTE: Lvalues are enumerated in place, as soon as there is an rvalue the arguments are copied or
+// moved into the array
+
+template<typename Size, typename T, typename... Ts>
+struct dispatch<detail::variadic_array_tag_t, Size, T, Ts...> {
+    using type = detail::range<
+        Size,
+        detail::conditional_t<
+            detail::all_of<
+                std::is_lvalue_reference<T>::value,
+                std::is_lvalue_reference<Ts>::value...>::value,
+            detail::reference_array<detail::remove_ref_t<T>, sizeof...(Ts) + 1>,
+            detail::array<detail::remove_cvref_t<T>, sizeof...(Ts) + 1>>>;
+};
+
+template<typename Size, typename T, typename T1>
+struct dispatch<detail::iterator_pointer_tag_t, Size, T, T1> {
+    using type
+        = detail::range<Size, detail::span<detail::remove_ref_t<T>, detail::remove_ref_t<T1>, Size>>;
+};
+
+template<typename Size, typename T, typename Sentinel>
+struct dispatch<detail::iterator_tag_t, Size, T, Sentinel> {
+    using type = detail::
+        range<Size, detail::span<detail::remove_ref_t<T>, detail::remove_ref_t<Sentinel>, Size>>;
+};
+
+template<typename Size, typename T>
+struct dispatch<detail::container_tag_t, Size, T> {
+    using type = detail::range<Size, detail::remove_rref_t<T>>;
+};
+
+template<typename Size, typename T>
+struct dispatch<detail::container_tag_t, Size, T&> {
+    using type = detail::view<Size, T>;
+};
+
+template<typename Size, typename T, typename TSize>
+struct dispatch<detail::container_size_tag_t, Size, T, TSize> {
+    using type = detail::limited_range<Size, detail::remove_rref_t<T>>;
+};
+
+template<typename Size, typename T, typename TSize>
+struct dispatch<detail::container_size_tag_t, Size, T&, TSize> {
+    using type = detail::limited_view<Size, T>;
+};
+
+template<typename Size, typename T>
+struct dispatch<detail::tuple_tag_t, Size, T> {
+    using type = detail::tuple_wrapper<Size, detail::remove_rref_t<T>, detail::remove_cvref_t<T>>;
+};
+
+template<typename Size, typename T, typename TSize>
+struct dispatch<detail::pointer_tag_t, Size, T, TSize> {
+    using type
+        = detail::range<Size, detail::span<detail::remove_ref_t<T>, detail::remove_ref_t<T>, Size>>;
+};
+
+template<typename Size, typename T>
+struct dispatch<detail::string_tag_t, Size, T> {
+    using type = detail::range<Size, detail::zstring_view<detail::decay_t<T>>>;
+};
+
+template<typename Size, typename T, Size N>
+struct dispatch<detail::array_tag_t, Size, T (&)[N]> {
+    using type = detail::
+        range<Size, detail::span<detail::remove_ref_t<T>*, detail::remove_ref_t<T>*, Size, N>>;
+};
+
+template<typename Size, typename T, Size N, typename TSize>
+struct dispatch<detail::array_tag_t, Size, T (&)[N], TSize> {
+    using type
+        = detail::range<Size, detail::span<detail::remove_ref_t<T>*, detail::remove_ref_t<T>*, Size>>;
+};
+
+#if HIPONY_ENUMERATE_HAS_AGGREGATES
+
+template<typename Size, typename T>
+struct dispatch<detail::aggregate_tag_t, Size, T> {
+    using type = detail::aggregate_wrapper<Size, T>;
+};
+
+#endif
+
+template<typename... Ts>
+using dispatch_t = typename dispatch<Ts...>::type;
+
+} // namespace detail
+
+template<typename T, typename... Ts>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
+enumerate(T&& t, Ts&&... ts) noexcept -> detail::dispatch_t<
+    detail::tag_t<
+        detail::size_t<detail::void_t<>, detail::remove_cvref_t<T>>,
+        detail::sanitize_t<T>,
+        detail::void_t<>,
+        detail::remove_cvref_t<Ts>...>,
+    detail::size_t<detail::void_t<>, detail::remove_cvref_t<T>>,
+    T,
+    Ts...>
+{
+    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
+}
+
+template<typename Size, typename T, typename... Ts>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
+enumerate_as(T&& t, Ts&&... ts) noexcept -> detail::dispatch_t<
+    detail::tag_t<
+        detail::size_t<Size, detail::remove_cvref_t<T>>,
+        detail::sanitize_t<T>,
+        detail::void_t<>,
+        detail::remove_cvref_t<Ts>...>,
+    detail::size_t<Size, detail::remove_cvref_t<T>>,
+    T,
+    Ts...>
+{
+    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
+}
+
+using HIPONY_ENUMERATE_NAMESPACE::as_tuple_tag_t;
+
+template<typename T, typename... Ts>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
+enumerate(as_tuple_tag_t /*_*/, T&& t, Ts&&... ts) noexcept -> detail::dispatch_t<
+    detail::variadic_tuple_tag_t,
+    detail::size_t<detail::void_t<>, detail::remove_cvref_t<T>>,
+    T,
+    Ts...>
+{
+    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
+}
+
+template<typename Size, typename T, typename... Ts>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
+enumerate_as(as_tuple_tag_t /*_*/, T&& t, Ts&&... ts) noexcept -> detail::
+    dispatch_t<detail::variadic_tuple_tag_t, detail::size_t<Size, detail::remove_cvref_t<T>>, T, Ts...>
+{
+    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
+}
+
+using HIPONY_ENUMERATE_NAMESPACE::as_array_tag_t;
+
+template<typename T, typename... Ts>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
+enumerate(as_array_tag_t /*_*/, T&& t, Ts&&... ts) noexcept -> detail::dispatch_t<
+    detail::variadic_array_tag_t,
+    detail::size_t<detail::void_t<>, detail::remove_cvref_t<T>>,
+    T,
+    Ts...>
+{
+    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
+}
+
+template<typename Size, typename T, typename... Ts>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
+enumerate_as(as_array_tag_t /*_*/, T&& t, Ts&&... ts) noexcept -> detail::
+    dispatch_t<detail::variadic_array_tag_t, detail::size_t<Size, detail::remove_cvref_t<T>>, T, Ts...>
+{
+    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
+}
+
+namespace detail {
+
+// NOTE: The C library scans for the terminator with vector instructions, the rest falls back to a
+// loop
+
+inline auto length(char const* str) noexcept -> std::size_t
+{
+    return std::strlen(str);
+}
+
+inline auto length(wchar_t const* str) noexcept -> std::size_t
+{
+    return std::wcslen(str);
+}
+
+#if HIPONY_ENUMERATE_HAS_CHAR8
+
+inline auto length(char8_t const* str) noexcept -> std::size_t
+{
+    return std::strlen(reinterpret_cast<char const*>(str));
+}
+
+#endif
+
+template<typename Char>
+inline auto length(Char const* str) noexcept -> std::size_t
+{
+    auto it = str;
+    while (*it != Char{}) {
+        ++it;
+    }
+    return static_cast<std::size_t>(it - str);
+}
+
+template<typename Size, typename Char>
+using string_span_t = typename detail::enable_if_t<
+    detail::is_string_literal<Char const>::value,
+    detail::range<
+        detail::size_t<Size, Char const*>,
+        detail::span<Char const*, Char const*, detail::size_t<Size, Char const*>>>>;
+
+} // namespace detail
+
+using HIPONY_ENUMERATE_NAMESPACE::as_span_tag_t;
+
+template<typename Char>
+HIPONY_ENUMERATE_NODISCARD inline auto enumerate(as_span_tag_t /*_*/, Char const* str) noexcept
+    -> detail::string_span_t<detail::void_t<>, Char>
+{
+    return {{str, str == nullptr ? str : str + detail::length(str)}};
+}
+
+template<typename Size, typename Char>
+HIPONY_ENUMERATE_NODISCARD inline auto enumerate_as(as_span_tag_t /*_*/, Char const* str) noexcept
+    -> detail::string_span_t<Size, Char>
+{
+    return {{str, str == nullptr ? str : str + detail::length(str)}};
+}
+
+namespace detail {
+
+template<typename Size, typename Char>
+using code_points_t = typename detail::enable_if_t<
+    detail::is_unicode_string<Char const>::value,
+    detail::range<detail::size_t<Size, Char const*>, detail::code_point_view<Char>>>;
+
+} // namespace detail
+
+using HIPONY_ENUMERATE_NAMESPACE::as_code_points_tag_t;
+using detail::code_point;
+
+template<typename Char>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate(as_code_points_tag_t /*_*/, Char const* str) noexcept
+    -> detail::code_points_t<detail::void_t<>, Char>
+{
+    return {{str, str == nullptr ? str : str + detail::length(str)}};
+}
+
+template<typename Char>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
+enumerate(as_code_points_tag_t /*_*/, Char const* first, Char const* last) noexcept
+    -> detail::code_points_t<detail::void_t<>, Char>
+{
+    return {{first, last}};
+}
+
+template<typename Size, typename Char>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_as(as_code_points_tag_t /*_*/, Char const* str) noexcept
+    -> detail::code_points_t<Size, Char>
+{
+    return {{str, str == nullptr ? str : str + detail::length(str)}};
+}
+
+template<typename Size, typename Char>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
+enumerate_as(as_code_points_tag_t /*_*/, Char const* first, Char const* last) noexcept
+    -> detail::code_points_t<Size, Char>
+{
+    return {{first, last}};
+}
+
+template<typename Char, typename Traits>
+HIPONY_ENUMERATE_NODISCARD inline auto enumerate(std::basic_istream<Char, Traits>& stream)
+    -> detail::range<
+        detail::size_t<detail::void_t<>, Char const*>,
+        detail::stream_blocks<Char, Traits>>
+{
+    return {{stream}};
+}
+
+template<typename Size, typename Char, typename Traits>
+HIPONY_ENUMERATE_NODISCARD inline auto enumerate_as(std::basic_istream<Char, Traits>& stream)
+    -> detail::range<detail::size_t<Size, Char const*>, detail::stream_blocks<Char, Traits>>
+{
+    return {{stream}};
+}
+
+#if HIPONY_ENUMERATE_HAS_BYTE
+
+namespace detail {
+
+template<typename Size, typename Prefix, typename Byte>
+using records_t = typename detail::enable_if_t<
+    detail::is_length_prefix<Prefix>::value && detail::is_byte<Byte>::value,
+    detail::range<detail::size_t<Size, std::byte const*>, detail::record_view<Prefix>>>;
+
+} // namespace detail
+
+using detail::byte_span;
+using detail::fixed_prefix;
+using detail::length_record;
+using detail::varint_prefix;
+
+// NOTE: Length-prefixed records are yielded as `length_record{offset, data}` pointing into the
+// buffer
+
+template<typename Prefix, typename Byte>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate(Prefix /*_*/, Byte const* first, Byte const* last) noexcept
+    -> detail::records_t<detail::void_t<>, Prefix, Byte>
+{
+    return {{reinterpret_cast<std::byte const*>(first), reinterpret_cast<std::byte const*>(last)}};
+}
+
+template<typename Prefix, typename Byte>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate(Prefix /*_*/, Byte const* data, std::size_t size) noexcept
+    -> detail::records_t<detail::void_t<>, Prefix, Byte>
+{
+    auto const first = reinterpret_cast<std::byte const*>(data);
+    return {{first, first + size}};
+}
+
+template<typename Size, typename Prefix, typename Byte>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_as(Prefix /*_*/, Byte const* first, Byte const* last) noexcept
+    -> detail::records_t<Size, Prefix, Byte>
+{
+    return {{reinterpret_cast<std::byte const*>(first), reinterpret_cast<std::byte const*>(last)}};
+}
+
+template<typename Size, typename Prefix, typename Byte>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_as(Prefix /*_*/, Byte const* data, std::size_t size) noexcept
+    -> detail::records_t<Size, Prefix, Byte>
+{
+    auto const first = reinterpret_cast<std::byte const*>(data);
+    return {{first, first + size}};
+}
+
+#endif
+
+#if HIPONY_ENUMERATE_HAS_FILES
+
+struct map_policy {
+    int  advice;
+    bool populate;
+    bool huge_pages;
+
+    HIPONY_ENUMERATE_CONSTEXPR explicit map_policy(
+        int advice_ = MADV_SEQUENTIAL, bool populate_ = false, bool huge_pages_ = false) noexcept
+        : advice{advice_}
+        , populate{populate_}
+        , huge_pages{huge_pages_}
+    {}
+};
+
+// NOTE: Read-only private mapping of a whole file, the pages are only read in when touched unless
+// the policy asks to populate them up front
+
+class mapped_file {
+    char const* _data = nullptr;
+    std::size_t _size = 0;
+
+    [[noreturn]] static void fail(int error, char const* path)
+    {
+        throw std::system_error(error, std::generic_category(), path);
+    }
+
+public:
+    mapped_file() = default;
+
+    explicit mapped_file(char const* path, int advice = MADV_SEQUENTIAL)
+        : mapped_file(path, map_policy{advice})
+    {}
+
+    explicit mapped_file(std::string const& path, int advice = MADV_SEQUENTIAL)
+        : mapped_file(path.c_str(), advice)
+    {}
+
+    mapped_file(char const* path, map_policy const& policy)
+    {
+        auto const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            fail(errno, path);
+        }
+        struct ::stat status {};
+        if (::fstat(fd, &status) == -1) {
+            auto const error = errno;
+            ::close(fd);
+            fail(error, path);
+        }
+        _size = static_cast<std::size_t>(status.st_size);
+        if (_size != 0) {
+            auto const flags = MAP_PRIVATE | (policy.populate ? MAP_POPULATE : 0);
+            auto const data  = ::mmap(nullptr, _size, PROT_READ, flags, fd, 0);
+            if (data == MAP_FAILED) {
+                auto const error = errno;
+                ::close(fd);
+                fail(error, path);
+            }
+            static_cast<void>(::madvise(data, _size, policy.advice));
+#if defined(MADV_HUGEPAGE)
+            // NOTE: Only a hint, page cache backed mappings get huge pages on kernels with
+            // read-only THP for file systems
+            if (policy.huge_pages) {
+                static_cast<void>(::madvise(data, _size, MADV_HUGEPAGE));
+            }
+#endif
+            _data = static_cast<char const*>(data);
+        }
+        ::close(fd);
+    }
+
+    mapped_file(std::string const& path, map_policy const& policy)
+        : mapped_file(path.c_str(), policy)
+    {}
+
+    mapped_file(mapped_file&& other) noexcept
+        : _data{other._data}
+        , _size{other._size}
+    {
+        other._data = nullptr;
+        other._size = 0;
+    }
+
+    auto operator=(mapped_file&& other) noexcept -> mapped_file&
+    {
+        auto tmp = static_cast<mapped_file&&>(other);
+        std::swap(_data, tmp._data);
+        std::swap(_size, tmp._size);
+        return *this;
+    }
+
+    mapped_file(mapped_file const&) = delete;
+    auto operator=(mapped_file const&) -> mapped_file& = delete;
+
+    ~mapped_file()
+    {
+        if (_data != nullptr) {
+            ::munmap(const_cast<char*>(_data), _size);
+        }
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto data() const noexcept -> char const*
+    {
+        return _data;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> std::size_t
+    {
+        return _size;
+    }
+};
+
+// NOTE: A file of fixed-width records viewed in place as an array of `T`, enumerating it yields
+// references straight into the page cache
+
+template<typename T>
+class mapped_array {
+    static_assert(std::is_trivially_copyable<T>::value, "Records have to be trivially copyable");
+
+    mapped_file _file;
+
+    void check(char const* path) const
+    {
+        if (_file.size() % sizeof(T) != 0) {
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument), path);
+        }
+    }
+
+public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using iterator       = T const*;
+    using const_iterator = T const*;
+
+    mapped_array() = default;
+
+    explicit mapped_array(char const* path, map_policy const& policy = map_policy{})
+        : _file{path, policy}
+    {
+        check(path);
+    }
+
+    explicit mapped_array(std::string const& path, map_policy const& policy = map_policy{})
+        : mapped_array(path.c_str(), policy)
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD auto data() const noexcept -> T const*
+    {
+        return reinterpret_cast<T const*>(_file.data());
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> size_type
+    {
+        return _file.size() / sizeof(T);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator[](size_type index) const noexcept -> T const&
+    {
+        assert(index < size() && "Index is out of range");
+        return data()[index];
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto begin() const noexcept -> const_iterator
+    {
+        return data();
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
+    {
+        return data() + size();
+    }
+};
+
+using detail::prefetch_policy;
+using detail::prefetch_stats;
+
+// NOTE: Memory enumerated with a sliding MADV_WILLNEED window ahead of the cursor, the memory has
+// to outlive the range. Pointers may come from anywhere, so `release` is ignored for them and only
+// honoured for a `mapped_array`
+
+template<typename T>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate(prefetch_policy const& policy, T const* first, T const* last)
+    -> detail::range<std::size_t, detail::prefetch_view<T>>
+{
+    return {{first, last, prefetch_policy{policy.window, false, policy.stats}}};
+}
+
+template<typename Size, typename T>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_as(prefetch_policy const& policy, T const* first, T const* last)
+    -> detail::range<detail::size_t<Size, T const*>, detail::prefetch_view<T>>
+{
+    return {{first, last, prefetch_policy{policy.window, false, policy.stats}}};
+}
+
+template<typename T>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate(prefetch_policy const& policy, mapped_array<T> const& array)
+    -> detail::range<std::size_t, detail::prefetch_view<T>>
+{
+    return {{array.begin(), array.end(), policy}};
+}
+
+template<typename T>
+void enumerate(prefetch_policy const& policy, mapped_array<T>&& array) = delete;
+
+template<typename Size, typename T>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_as(prefetch_policy const& policy, mapped_array<T> const& array)
+    -> detail::range<detail::size_t<Size, T const*>, detail::prefetch_view<T>>
+{
+    return {{array.begin(), array.end(), policy}};
+}
+
+template<typename Size, typename T>
+void enumerate_as(prefetch_policy const& policy, mapped_array<T>&& array) = delete;
+
+// NOTE: A POSIX shared memory segment viewed as an array of `T`, a `T const` array attaches
+// read-only. The segment outlives the processes until it's removed by name
+
+template<typename T>
+class shared_array {
+    static_assert(std::is_trivially_copyable<T>::value, "Elements have to be trivially copyable");
+
+    using element_type = typename std::remove_const<T>::type;
+
+    T*          _data = nullptr;
+    std::size_t _size = 0;
+
+    [[noreturn]] static void fail(int error, char const* name)
+    {
+        throw std::system_error(error, std::generic_category(), name);
+    }
+
+    void map(int fd, std::size_t bytes, char const* name)
+    {
+        _size = bytes / sizeof(T);
+        if (bytes != 0) {
+            auto const protection = std::is_const<T>::value ? PROT_READ : PROT_READ | PROT_WRITE;
+            auto const data       = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED) {
+                auto const error = errno;
+                ::close(fd);
+                fail(error, name);
+            }
+            _data = static_cast<T*>(data);
+        }
+        ::close(fd);
+    }
+
+public:
+    using value_type     = element_type;
+    using size_type      = std::size_t;
+    using iterator       = T*;
+    using const_iterator = T const*;
+
+    shared_array() = default;
+
+    // NOTE: Attaches to an existing segment, the size is taken from the segment
+    explicit shared_array(char const* name)
+    {
+        auto const fd = ::shm_open(name, std::is_const<T>::value ? O_RDONLY : O_RDWR, 0);
+        if (fd == -1) {
+            fail(errno, name);
+        }
+        struct ::stat status {};
+        if (::fstat(fd, &status) == -1) {
+            auto const error = errno;
+            ::close(fd);
+            fail(error, name);
+        }
+        auto const bytes = static_cast<std::size_t>(status.st_size);
+        if (bytes % sizeof(T) != 0) {
+            ::close(fd);
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument), name);
+        }
+        map(fd, bytes, name);
+    }
+
+    explicit shared_array(std::string const& name)
+        : shared_array(name.c_str())
+    {}
+
+    // NOTE: Creates a zero-filled segment of `size` elements, failing if the name is taken
+    HIPONY_ENUMERATE_NODISCARD static auto
+    create(char const* name, std::size_t size, ::mode_t mode = 0600) -> shared_array
+    {
+        static_assert(!std::is_const<T>::value, "Read-only arrays can only attach");
+        auto const limit = static_cast<std::uintmax_t>((std::numeric_limits<::off_t>::max)());
+        if (size > limit / sizeof(T)
+            || size > (std::numeric_limits<std::size_t>::max)() / sizeof(T)) {
+            fail(EOVERFLOW, name);
+        }
+        auto const bytes = size * sizeof(T);
+        auto const fd    = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, mode);
+        if (fd == -1) {
+            fail(errno, name);
+        }
+        // NOTE: The segment is ours from here on, it's unlinked again on any failure
+        if (::ftruncate(fd, static_cast<::off_t>(bytes)) == -1) {
+            auto const error = errno;
+            ::close(fd);
+            ::shm_unlink(name);
+            fail(error, name);
+        }
+        auto array = shared_array{};
+        try {
+            array.map(fd, bytes, name);
+        } catch (...) {
+            ::shm_unlink(name);
+            throw;
+        }
+        return array;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD static auto
+    create(std::string const& name, std::size_t size, ::mode_t mode = 0600) -> shared_array
+    {
+        return create(name.c_str(), size, mode);
+    }
+
+    // NOTE: Existing mappings stay valid, new attaches fail
+    static auto remove(char const* name) noexcept -> bool
+    {
+        return ::shm_unlink(name) == 0;
+    }
+
+    static auto remove(std::string const& name) noexcept -> bool
+    {
+        return remove(name.c_str());
+    }
+
+    shared_array(shared_array&& other) noexcept
+        : _data{other._data}
+        , _size{other._size}
+    {
+        other._data = nullptr;
+        other._size = 0;
+    }
+
+    auto operator=(shared_array&& other) noexcept -> shared_array&
+    {
+        auto tmp = static_cast<shared_array&&>(other);
+        std::swap(_data, tmp._data);
+        std::swap(_size, tmp._size);
+        return *this;
+    }
+
+    shared_array(shared_array const&)                    = delete;
+    auto operator=(shared_array const&) -> shared_array& = delete;
+
+    ~shared_array()
+    {
+        if (_data != nullptr) {
+            ::munmap(const_cast<element_type*>(_data), _size * sizeof(T));
+        }
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto data() noexcept -> T*
+    {
+        return _data;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto data() const noexcept -> T const*
+    {
+        return _data;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> size_type
+    {
+        return _size;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto empty() const noexcept -> bool
+    {
+        return _size == 0;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator[](size_type index) noexcept -> T&
+    {
+        assert(index < _size && "Index is out of range");
+        return _data[index];
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator[](size_type index) const noexcept -> T const&
+    {
+        assert(index < _size && "Index is out of range");
+        return _data[index];
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto begin() noexcept -> iterator
+    {
+        return _data;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto end() noexcept -> iterator
+    {
+        return _data + _size;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto begin() const noexcept -> const_iterator
+    {
+        return _data;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
+    {
+        return _data + _size;
+    }
+};
+
+#endif
+
+#if HIPONY_ENUMERATE_HAS_STRING_VIEW
+
+// NOTE: Offsets of the line starts, built with a single pass over the text. Enumerating lines with
+// an index is random-access, so seeking to a line and splitting into chunks is O(1)
+
+class line_index {
+    std::vector<std::uint64_t> _offsets;
+    std::uint64_t              _text_size = 0;
+
+#if HIPONY_ENUMERATE_HAS_FILES
+
+    static constexpr std::uint64_t magic = 0x3158444E4C4E5948u; // "HYNLNDX1"
+
+    [[noreturn]] static void fail(int error, char const* path)
+    {
+        throw std::system_error(error, std::generic_category(), path);
+    }
+
+    static void write_word(std::uint64_t value, unsigned char* ptr) noexcept
+    {
+        for (std::size_t i = 0; i < sizeof(value); ++i) {
+            ptr[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    HIPONY_ENUMERATE_NODISCARD static auto read_word(char const* ptr) noexcept -> std::uint64_t
+    {
+        unsigned char bytes[sizeof(std::uint64_t)];
+        std::memcpy(bytes, ptr, sizeof(bytes));
+        auto value = std::uint64_t{};
+        for (std::size_t i = 0; i < sizeof(value); ++i) {
+            value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+        }
+        return value;
+    }
+
+#endif
+
+public:
+    line_index() = default;
+
+    explicit line_index(std::string_view text)
+        : _text_size{text.size()}
+    {
+        auto const first = text.data();
+        auto const last  = first + text.size();
+        auto       ptr   = first;
+        while (ptr != last) {
+            _offsets.push_back(static_cast<std::uint64_t>(ptr - first));
+            auto const eol = std::memchr(ptr, '\n', static_cast<std::size_t>(last - ptr));
+            ptr            = eol != nullptr ? static_cast<char const*>(eol) + 1 : last;
+        }
+        auto const terminated = !text.empty() && text.back() == '\n';
+        _offsets.push_back(_text_size + (terminated ? 0 : 1));
+    }
+
+#if HIPONY_ENUMERATE_HAS_FILES
+
+    explicit line_index(mapped_file const& file)
+        : line_index(std::string_view(file.data(), file.size()))
+    {}
+
+    // NOTE: The sidecar file is a little-endian sequence of 64-bit words, the magic with its format
+    // version, the size of the text, the line count and the offsets. A stale index is rejected on
+    // load
+
+    void save(char const* path) const
+    {
+        constexpr auto word  = sizeof(std::uint64_t);
+        auto           bytes = std::vector<unsigned char>((3 + _offsets.size()) * word);
+        write_word(magic, bytes.data());
+        write_word(_text_size, bytes.data() + word);
+        write_word(_offsets.size(), bytes.data() + 2 * word);
+        for (std::size_t i = 0; i < _offsets.size(); ++i) {
+            write_word(_offsets[i], bytes.data() + (3 + i) * word);
+        }
+
+        auto const file = std::fopen(path, "wb");
+        if (file == nullptr) {
+            fail(errno, path);
+        }
+        auto error = 0;
+        if (std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+            error = errno != 0 ? errno : EIO;
+        }
+        if (std::fclose(file) != 0 && error == 0) {
+            error = errno;
+        }
+        if (error != 0) {
+            fail(error, path);
+        }
+    }
+
+    void save(std::string const& path) const
+    {
+        save(path.c_str());
+    }
+
+    HIPONY_ENUMERATE_NODISCARD static auto load(char const* path, std::uint64_t text_size)
+        -> line_index
+    {
+        constexpr auto word    = sizeof(std::uint64_t);
+        auto const     sidecar = mapped_file(path, MADV_WILLNEED);
+        auto const     words   = sidecar.size() / word;
+        auto const     data    = sidecar.data();
+        if (words < 3 || sidecar.size() % word != 0) {
+            fail(EINVAL, path);
+        }
+        if (read_word(data) != magic || read_word(data + word) != text_size
+            || read_word(data + 2 * word) != words - 3) {
+            fail(EINVAL, path);
+        }
+
+        // NOTE: Offsets are checked to be in bounds of the text, so a corrupted sidecar can't make
+        // a line escape it. A rewrite of the text that keeps its size isn't detected
+
+        auto index       = line_index{};
+        index._text_size = text_size;
+        index._offsets.resize(words - 3);
+        for (std::size_t i = 0; i < index._offsets.size(); ++i) {
+            auto const offset = read_word(data + (3 + i) * word);
+            if (i == 0 ? offset != 0 && words > 4 : offset <= index._offsets[i - 1]) {
+                fail(EINVAL, path);
+            }
+            index._offsets[i] = offset;
+        }
+        if (!index._offsets.empty()
+            && (index._offsets.back() < text_size || index._offsets.back() > text_size + 1)) {
+            fail(EINVAL, path);
+        }
+        return index;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD static auto load(std::string const& path, std::uint64_t text_size)
+        -> line_index
+    {
+        return load(path.c_str(), text_size);
+    }
+
+#endif
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> std::size_t
+    {
+        return _offsets.empty() ? 0 : _offsets.size() - 1;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto text_size() const noexcept -> std::uint64_t
+    {
+        return _text_size;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto offset(std::size_t line) const noexcept -> std::uint64_t
+    {
+        assert(line < _offsets.size() && "Line is out of range");
+        return _offsets[line];
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto data() const noexcept -> std::uint64_t const*
+    {
+        return _offsets.data();
+    }
+};
+
+namespace detail {
+
+template<typename Size, typename Storage>
+using lines_t = detail::range<detail::size_t<Size, char const*>, detail::lines<Storage>>;
+
+template<typename Size, typename Storage>
+using indexed_lines_t
+    = detail::range<detail::size_t<Size, char const*>, detail::indexed_lines<Storage>>;
+
+} // namespace detail
+
+HIPONY_ENUMERATE_NODISCARD inline auto enumerate_lines(std::string_view text) noexcept
+    -> detail::lines_t<detail::void_t<>, std::string_view>
+{
+    return {{text}};
+}
+
+template<typename Size>
+HIPONY_ENUMERATE_NODISCARD inline auto enumerate_lines_as(std::string_view text) noexcept
+    -> detail::lines_t<Size, std::string_view>
+{
+    return {{text}};
+}
+
+// NOTE: The index should outlive the range
+
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_lines(std::string_view text, line_index const& index) noexcept
+    -> detail::indexed_lines_t<detail::void_t<>, std::string_view>
+{
+    assert(index.text_size() == text.size() && "Index was built for a different text");
+    return {{text, index.data(), index.size()}};
+}
+
+template<typename Size>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_lines_as(std::string_view text, line_index const& index) noexcept
+    -> detail::indexed_lines_t<Size, std::string_view>
+{
+    assert(index.text_size() == text.size() && "Index was built for a different text");
+    return {{text, index.data(), index.size()}};
+}
+
+using detail::csv_dialect;
+using detail::csv_field;
+
+// NOTE: Fields of delimited text, the index counts the fields and the value carries the row and
+// column. Pass `csv_dialect{'\t'}` for TSV
+
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate(csv_dialect const& dialect, std::string_view text) noexcept
+    -> detail::range<std::size_t, detail::csv_view>
+{
+    return {{text, dialect}};
+}
+
+template<typename Size>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_as(csv_dialect const& dialect, std::string_view text) noexcept
+    -> detail::range<detail::size_t<Size, char const*>, detail::csv_view>
+{
+    return {{text, dialect}};
+}
+
+#endif
+
+#if HIPONY_ENUMERATE_HAS_FILES
+
+HIPONY_ENUMERATE_NODISCARD inline auto enumerate_lines(mapped_file file) noexcept
+    -> detail::lines_t<detail::void_t<>, mapped_file>
+{
+    return {{static_cast<mapped_file&&>(file)}};
+}
+
+template<typename Size>
+HIPONY_ENUMERATE_NODISCARD inline auto enumerate_lines_as(mapped_file file) noexcept
+    -> detail::lines_t<Size, mapped_file>
+{
+    return {{static_cast<mapped_file&&>(file)}};
+}
+
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_lines(mapped_file file, line_index const& index) noexcept
+    -> detail::indexed_lines_t<detail::void_t<>, mapped_file>
+{
+    assert(index.text_size() == file.size() && "Index was built for a different file");
+    return {{static_cast<mapped_file&&>(file), index.data(), index.size()}};
+}
+
+template<typename Size>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_lines_as(mapped_file file, line_index const& index) noexcept
+    -> detail::indexed_lines_t<Size, mapped_file>
+{
+    assert(index.text_size() == file.size() && "Index was built for a different file");
+    return {{static_cast<mapped_file&&>(file), index.data(), index.size()}};
+}
+
+struct block_policy {
+    std::size_t block_size;
+    std::size_t depth;
+    bool        io_uring;
+
+    HIPONY_ENUMERATE_CONSTEXPR explicit block_policy(
+        std::size_t block_size_ = 0,
+        std::size_t depth_      = 0,
+        bool        io_uring_   = true) noexcept
+        : block_size{block_size_}
+        , depth{depth_}
+        , io_uring{io_uring_}
+    {}
+};
+
+namespace detail {
+
+[[noreturn]] inline void io_error(int error, char const* what)
+{
+    throw std::system_error(error, std::generic_category(), what);
+}
+
+// NOTE: Reads until `size` bytes or the end of the file, a short read isn't an error for a pread
+inline auto read_fully(int fd, std::byte* buffer, std::size_t size, std::uint64_t offset)
+    -> std::size_t
+{
+    auto done = std::size_t{0};
+    while (done < size) {
+        auto const count
+            = ::pread(fd, buffer + done, size - done, static_cast<::off_t>(offset + done));
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            detail::io_error(errno, "pread");
+        }
+        if (count == 0) {
+            break;
+        }
+        done += static_cast<std::size_t>(count);
+    }
+    return done;
+}
+
+class file_descriptor {
+    int _fd = -1;
+
+public:
+    file_descriptor() = default;
+
+    explicit file_descriptor(int fd) noexcept
+        : _fd{fd}
+    {}
+
+    file_descriptor(file_descriptor const&)                    = delete;
+    auto operator=(file_descriptor const&) -> file_descriptor& = delete;
+
+    ~file_descriptor()
+    {
+        if (_fd != -1) {
+            ::close(_fd);
+        }
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto get() const noexcept -> int
+    {
+        return _fd;
+    }
+};
+
+// NOTE: A slot is in flight from its submission until the completion is observed, only then the
+// buffer may be reused or released
+
+struct block_slot {
+    std::unique_ptr<std::byte[]> buffer;
+    ::iovec                      vector{};
+    std::uint64_t                offset    = 0;
+    std::size_t                  size      = 0;
+    long                         result    = 0;
+    bool                         in_flight = false;
+};
+
+#if HIPONY_ENUMERATE_HAS_IO_URING
+
+// NOTE: Minimal io_uring submission and completion rings over the raw system calls, only the
+// consumer thread touches them
+
+class uring {
+    int                   _fd        = -1;
+    void*                 _sq_ring   = MAP_FAILED;
+    void*                 _cq_ring   = MAP_FAILED;
+    std::size_t           _sq_size   = 0;
+    std::size_t           _cq_size   = 0;
+    ::io_uring_sqe*       _sqes      = static_cast<::io_uring_sqe*>(MAP_FAILED);
+    std::size_t           _sqes_size = 0;
+    unsigned*             _sq_tail   = nullptr;
+    unsigned const*       _sq_mask   = nullptr;
+    unsigned*             _sq_array  = nullptr;
+    unsigned*             _cq_head   = nullptr;
+    unsigned const*       _cq_tail   = nullptr;
+    unsigned const*       _cq_mask   = nullptr;
+    ::io_uring_cqe const* _cqes      = nullptr;
+
+    template<typename T>
+    static auto at(void* ring, unsigned offset) noexcept -> T*
+    {
+        return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+    }
+
+    void enter(unsigned submit, unsigned wait)
+    {
+        auto const flags = wait > 0 ? IORING_ENTER_GETEVENTS : 0u;
+        while (::syscall(__NR_io_uring_enter, _fd, submit, wait, flags, nullptr, 0) < 0) {
+            if (errno != EINTR) {
+                detail::io_error(errno, "io_uring_enter");
+            }
+        }
+    }
+
+public:
+    uring()                                = default;
+    uring(uring const&)                    = delete;
+    auto operator=(uring const&) -> uring& = delete;
+
+    ~uring()
+    {
+        if (_sqes != MAP_FAILED) {
+            ::munmap(_sqes, _sqes_size);
+        }
+        if (_cq_ring != MAP_FAILED && _cq_ring != _sq_ring) {
+            ::munmap(_cq_ring, _cq_size);
+        }
+        if (_sq_ring != MAP_FAILED) {
+            ::munmap(_sq_ring, _sq_size);
+        }
+        if (_fd != -1) {
+            ::close(_fd);
+        }
+    }
+
+    // NOTE: False when the kernel doesn't provide io_uring or it's disabled by the sandbox
+    auto open(unsigned entries) noexcept -> bool
+    {
+        auto params = ::io_uring_params{};
+        _fd         = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (_fd < 0) {
+            _fd = -1;
+            return false;
+        }
+
+        _sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cq_size = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+        auto const single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) {
+            _sq_size = _cq_size = (std::max)(_sq_size, _cq_size);
+        }
+        _sq_ring = ::mmap(
+            nullptr,
+            _sq_size,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            _fd,
+            IORING_OFF_SQ_RING);
+        if (_sq_ring == MAP_FAILED) {
+            return false;
+        }
+        _cq_ring = single ? _sq_ring
+                          : ::mmap(
+                              nullptr,
+                              _cq_size,
+                              PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE,
+                              _fd,
+                              IORING_OFF_CQ_RING);
+        if (_cq_ring == MAP_FAILED) {
+            return false;
+        }
+        _sqes_size = params.sq_entries * sizeof(::io_uring_sqe);
+        _sqes      = static_cast<::io_uring_sqe*>(::mmap(
+            nullptr,
+            _sqes_size,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            _fd,
+            IORING_OFF_SQES));
+        if (_sqes == MAP_FAILED) {
+            return false;
+        }
+
+        _sq_tail  = at<unsigned>(_sq_ring, params.sq_off.tail);
+        _sq_mask  = at<unsigned>(_sq_ring, params.sq_off.ring_mask);
+        _sq_array = at<unsigned>(_sq_ring, params.sq_off.array);
+        _cq_head  = at<unsigned>(_cq_ring, params.cq_off.head);
+        _cq_tail  = at<unsigned>(_cq_ring, params.cq_off.tail);
+        _cq_mask  = at<unsigned>(_cq_ring, params.cq_off.ring_mask);
+        _cqes     = at<::io_uring_cqe>(_cq_ring, params.cq_off.cqes);
+        return true;
+    }
+
+    void read(int fd, block_slot& slot, std::uint64_t id)
+    {
+        auto const tail  = *_sq_tail;
+        auto const index = tail & *_sq_mask;
+        auto&      sqe   = _sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        slot.vector      = ::iovec{slot.buffer.get(), slot.size};
+        sqe.opcode       = IORING_OP_READV;
+        sqe.fd           = fd;
+        sqe.off          = slot.offset;
+        sqe.addr         = reinterpret_cast<std::uint64_t>(&slot.vector);
+        sqe.len          = 1;
+        sqe.user_data    = id;
+        _sq_array[index] = index;
+        __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+        enter(1, 0);
+    }
+
+    // NOTE: Blocks for the next completion in the order the kernel finishes them
+    auto complete(long& result) -> std::uint64_t
+    {
+        for (;;) {
+            auto const head = *_cq_head;
+            if (head != __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE)) {
+                auto const& cqe = _cqes[head & *_cq_mask];
+                auto const  id  = cqe.user_data;
+                result          = cqe.res;
+                __atomic_store_n(_cq_head, head + 1, __ATOMIC_RELEASE);
+                return id;
+            }
+            enter(0, 1);
+        }
+    }
+};
+
+#endif
+
+// NOTE: Blocks are yielded in order, block `i` always goes through slot `i % depth`. A slot is
+// resubmitted for the block `depth` positions ahead as soon as the consumer moves past it
+
+class block_reader {
+    detail::file_descriptor _file;
+    std::uint64_t           _file_size = 0;
+    std::size_t             _block_size;
+    std::size_t             _count;
+    std::vector<block_slot> _slots;
+    std::size_t             _submitted = 0;
+    std::size_t             _in_flight = 0;
+
+#if HIPONY_ENUMERATE_HAS_IO_URING
+    std::unique_ptr<uring> _uring;
+#endif
+
+    // NOTE: Fallback when io_uring isn't available, a pool of threads issuing blocking preads
+    std::mutex               _mutex;
+    std::condition_variable  _wake;
+    std::deque<std::size_t>  _queue;
+    std::vector<std::thread> _workers;
+    bool                     _stop = false;
+
+    void work()
+    {
+        for (;;) {
+            auto id = std::size_t{};
+            {
+                std::unique_lock<std::mutex> lock{_mutex};
+                _wake.wait(lock, [this] { return _stop || !_queue.empty(); });
+                if (_queue.empty()) {
+                    return;
+                }
+                id = _queue.front();
+                _queue.pop_front();
+            }
+            auto& slot   = _slots[id];
+            auto  result = long{};
+            try {
+                result = static_cast<long>(
+                    detail::read_fully(_file.get(), slot.buffer.get(), slot.size, slot.offset));
+            } catch (std::system_error const& error) {
+                result = -error.code().value();
+            }
+            {
+                std::lock_guard<std::mutex> lock{_mutex};
+                slot.result    = result;
+                slot.in_flight = false;
+                --_in_flight;
+            }
+            _wake.notify_all();
+        }
+    }
+
+    void submit(std::size_t block)
+    {
+        auto const id   = block % _slots.size();
+        auto&      slot = _slots[id];
+        slot.offset     = static_cast<std::uint64_t>(block) * _block_size;
+        slot.size       = static_cast<std::size_t>(
+            (std::min)(static_cast<std::uint64_t>(_block_size), _file_size - slot.offset));
+#if HIPONY_ENUMERATE_HAS_IO_URING
+        if (_uring) {
+            _uring->read(_file.get(), slot, id);
+            slot.in_flight = true;
+            ++_in_flight;
+            return;
+        }
+#endif
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            slot.in_flight = true;
+            ++_in_flight;
+            _queue.push_back(id);
+        }
+        _wake.notify_all();
+    }
+
+#if HIPONY_ENUMERATE_HAS_IO_URING
+    // NOTE: Completions arrive in the order the kernel finishes them, not in submission order
+    void reap()
+    {
+        auto  result   = long{};
+        auto& slot     = _slots[_uring->complete(result)];
+        slot.result    = result;
+        slot.in_flight = false;
+        --_in_flight;
+    }
+#endif
+
+    auto wait(std::size_t id) -> block_slot&
+    {
+        auto& slot = _slots[id];
+#if HIPONY_ENUMERATE_HAS_IO_URING
+        if (_uring) {
+            while (slot.in_flight) {
+                reap();
+            }
+        }
+#endif
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _wake.wait(lock, [&slot] { return !slot.in_flight; });
+        }
+        if (slot.result < 0) {
+            detail::io_error(static_cast<int>(-slot.result), "read");
+        }
+        // NOTE: Finishes a short asynchronous read synchronously
+        auto const read = static_cast<std::size_t>(slot.result);
+        if (read < slot.size) {
+            slot.size = read
+                        + detail::read_fully(
+                            _file.get(),
+                            slot.buffer.get() + read,
+                            slot.size - read,
+                            slot.offset + read);
+        }
+        return slot;
+    }
+
+    // NOTE: Waits for every read in flight, queued reads that haven't started are dropped
+    void drain()
+    {
+#if HIPONY_ENUMERATE_HAS_IO_URING
+        if (_uring) {
+            while (_in_flight > 0) {
+                reap();
+            }
+            return;
+        }
+#endif
+        std::unique_lock<std::mutex> lock{_mutex};
+        for (auto const id : _queue) {
+            _slots[id].in_flight = false;
+            --_in_flight;
+        }
+        _queue.clear();
+        _wake.wait(lock, [this] { return _in_flight == 0; });
+    }
+
+    void stop() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stop = true;
+            _queue.clear();
+        }
+        _wake.notify_all();
+        for (auto& worker : _workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+public:
+    block_reader(char const* path, block_policy const& policy)
+        : _file{::open(path, O_RDONLY | O_CLOEXEC)}
+        , _block_size{policy.block_size > 0 ? policy.block_size : std::size_t{1} << 20}
+    {
+        if (_file.get() == -1) {
+            detail::io_error(errno, path);
+        }
+        struct ::stat status {};
+        if (::fstat(_file.get(), &status) == -1) {
+            detail::io_error(errno, path);
+        }
+        _file_size = static_cast<std::uint64_t>(status.st_size);
+        _count     = static_cast<std::size_t>((_file_size + _block_size - 1) / _block_size);
+
+        auto const depth = (std::min)(
+            policy.depth > 0 ? policy.depth : std::size_t{4}, (std::max)(_count, std::size_t{1}));
+        _slots.resize(depth);
+        for (auto& slot : _slots) {
+            slot.buffer.reset(new std::byte[_block_size]);
+        }
+#if HIPONY_ENUMERATE_HAS_IO_URING
+        if (policy.io_uring) {
+            _uring.reset(new uring{});
+            if (!_uring->open(static_cast<unsigned>(depth))) {
+                _uring.reset();
+            }
+        }
+        if (_uring) {
+            return;
+        }
+#endif
+        // NOTE: The destructor doesn't run for a failed constructor, join the started workers here
+        try {
+            _workers.reserve(depth);
+            for (std::size_t i = 0; i < depth; ++i) {
+                _workers.emplace_back([this] { work(); });
+            }
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    block_reader(block_reader const&)                    = delete;
+    auto operator=(block_reader const&) -> block_reader& = delete;
+
+    // NOTE: The buffers are only released after the reads in flight land. If waiting for them
+    // fails, the buffers they still target are leaked rather than throwing from the destructor
+    ~block_reader()
+    {
+        try {
+            drain();
+        } catch (...) {
+            for (auto& slot : _slots) {
+                if (slot.in_flight) {
+                    static_cast<void>(slot.buffer.release());
+                }
+            }
+        }
+        stop();
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto count() const noexcept -> std::size_t
+    {
+        return _count;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto uses_io_uring() const noexcept -> bool
+    {
+#if HIPONY_ENUMERATE_HAS_IO_URING
+        return static_cast<bool>(_uring);
+#else
+        return false;
+#endif
+    }
+
+    // NOTE: Restarts the pipeline at `block`, the reads of an earlier pass are drained first so no
+    // buffer is resubmitted while the kernel or a worker still writes into it
+    auto start(std::size_t block) -> byte_span
+    {
+        drain();
+        for (_submitted = block; _submitted < _count && _submitted - block < _slots.size();) {
+            submit(_submitted++);
+        }
+        return get(block);
+    }
+
+    auto next(std::size_t block) -> byte_span
+    {
+        if (_submitted < _count) {
+            submit(_submitted++);
+        }
+        return get(block);
+    }
+
+    auto get(std::size_t block) -> byte_span
+    {
+        auto const& slot = wait(block % _slots.size());
+        return {slot.buffer.get(), slot.size};
+    }
+};
+
+class block_iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = byte_span;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = byte_span const*;
+    using reference         = byte_span const&;
+
+private:
+    block_reader* _reader = nullptr;
+    std::size_t   _block  = 0;
+    byte_span     _span{nullptr, std::size_t{0}};
+
+public:
+    block_iterator() = default;
+
+    block_iterator(block_reader* reader)
+        : _reader{reader}
+    {
+        if (_reader->count() == 0) {
+            _reader = nullptr;
+            return;
+        }
+        _span = _reader->start(0);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto operator*() const noexcept -> reference
+    {
+        return _span;
+    }
+
+    auto operator++() -> block_iterator&
+    {
+        if (++_block == _reader->count()) {
+            _reader = nullptr;
+            return *this;
+        }
+        _span = _reader->next(_block);
+        return *this;
+    }
+
+    void operator++(int)
+    {
+        ++(*this);
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator==(block_iterator const& lhs, block_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._reader == rhs._reader;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator!=(block_iterator const& lhs, block_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
+
+} // namespace detail
+
+// NOTE: Reads a file in fixed-size blocks with several reads in flight, through io_uring on Linux
+// and a pool of threads issuing preads otherwise. It's an input range, another begin() waits for
+// the reads in flight and restarts at the first block
+
+class file_blocks {
+    std::unique_ptr<detail::block_reader> _reader;
+
+public:
+    using value_type     = byte_span;
+    using iterator       = detail::block_iterator;
+    using const_iterator = iterator;
+
+    explicit file_blocks(char const* path, block_policy const& policy = block_policy{})
+        : _reader{new detail::block_reader(path, policy)}
+    {}
+
+    explicit file_blocks(std::string const& path, block_policy const& policy = block_policy{})
+        : file_blocks(path.c_str(), policy)
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD auto begin() const -> const_iterator
+    {
+        return {_reader.get()};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
+    {
+        return {};
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> std::size_t
+    {
+        return _reader->count();
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto uses_io_uring() const noexcept -> bool
+    {
+        return _reader->uses_io_uring();
+    }
+};
+
+#endif
+
+template<typename T>
+HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto until(T value) noexcept
+    -> detail::value_sentinel<T>
+{
+    return {static_cast<T&&>(value)};
+}
+
+template<typename Range>
+HIPONY_ENUMERATE_NODISCARD inline auto split(Range&& range, std::ptrdiff_t count) ->
+    typename detail::splittable<Range>::type
+{
+    using difference_type = typename detail::splittable<Range>::difference_type;
+
+    assert(count > 0 && "Count should be positive");
+    auto const size
+        = static_cast<difference_type>(std::distance(range.begin(), detail::common_end(range)));
+    auto const n = static_cast<difference_type>(count);
+    return {range.begin(), size, n, size / n, size % n};
+}
+
+template<typename Range>
+HIPONY_ENUMERATE_NODISCARD inline auto chunks(Range&& range, std::ptrdiff_t length) ->
+    typename detail::splittable<Range>::type
+{
+    using difference_type = typename detail::splittable<Range>::difference_type;
+
+    assert(length > 0 && "Length should be positive");
+    auto const size
+        = static_cast<difference_type>(std::distance(range.begin(), detail::common_end(range)));
+    auto const n = static_cast<difference_type>(length);
+    return {range.begin(), size, (size + n - 1) / n, n, 0};
+}
+
+// NOTE: Skips the first `count` elements in O(1) for random-access ranges, the indices are kept
+
+template<typename Range>
+HIPONY_ENUMERATE_NODISCARD inline auto seek(Range&& range, std::ptrdiff_t count)
+    -> detail::subrange<detail::range_iterator_t<Range>>
+{
+    using difference_type = typename detail::splittable<Range>::difference_type;
     static_assert(
-        !detail::is_narrow_convertible<TSize, Size>::value,
-        "Narrowing conversions for Size are not allowed. Either cast it explicitly or use the "
-        "`_as<Size>` overload.");
-    using type = pointer_tag_t;
+        detail::is_random_access_iterator<detail::range_iterator_t<Range>>::value,
+        "Seeking requires a random-access range");
+
+    auto const first = range.begin();
+    auto const last  = range.end();
+    assert(count >= 0 && count <= last - first && "Count is out of range");
+    return {first + static_cast<difference_type>(count), last};
+}
+
+template<typename Range>
+HIPONY_ENUMERATE_NODISCARD inline auto blocked(Range&& range, std::ptrdiff_t grain = 1) ->
+    typename detail::splittable<Range>::blocked_type
+{
+    using difference_type = typename detail::splittable<Range>::difference_type;
+
+    return {range.begin(), detail::common_end(range), static_cast<difference_type>(grain)};
+}
+
+#if HIPONY_ENUMERATE_HAS_EXECUTION
+
+namespace detail {
+
+template<typename ExecutionPolicy, typename Range, typename F>
+inline void for_each(std::true_type /*random_access*/, ExecutionPolicy&& policy, Range& range, F& f)
+{
+    std::for_each(static_cast<ExecutionPolicy&&>(policy), range.begin(), range.end(), f);
+}
+
+template<typename ExecutionPolicy, typename Range, typename F>
+inline void
+for_each(std::false_type /*random_access*/, ExecutionPolicy&& /*policy*/, Range& range, F& f)
+{
+    for (auto&& item : range) {
+        f(item);
+    }
+}
+
+} // namespace detail
+
+// NOTE: Only random-access ranges are handed to the policy, the rest fall back to a serial loop
+template<typename ExecutionPolicy, typename Range, typename F>
+inline auto for_each(ExecutionPolicy&& policy, Range&& range, F f) -> detail::enable_if_t<
+    std::is_execution_policy<detail::remove_cvref_t<ExecutionPolicy>>::value>
+{
+    detail::for_each(
+        detail::is_random_access_enumerate<detail::remove_ref_t<Range>>{},
+        static_cast<ExecutionPolicy&&>(policy),
+        range,
+        f);
+}
+
+#endif
+
+#if HIPONY_ENUMERATE_HAS_PARALLEL
+
+struct work_stealing_policy {
+    std::size_t    concurrency;
+    std::ptrdiff_t grain;
+
+    HIPONY_ENUMERATE_CONSTEXPR explicit work_stealing_policy(
+        std::size_t    concurrency_ = 0,
+        std::ptrdiff_t grain_       = 0) noexcept
+        : concurrency{concurrency_}
+        , grain{grain_}
+    {}
 };
 
-template<typename Size>
-struct tag<Size, char const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
+HIPONY_ENUMERATE_MAYBE_UNUSED HIPONY_ENUMERATE_CONSTEXPR auto const work_stealing
+    = work_stealing_policy{};
+
+struct self_scheduling_policy {
+    std::size_t    concurrency;
+    std::ptrdiff_t block;
+
+    HIPONY_ENUMERATE_CONSTEXPR explicit self_scheduling_policy(
+        std::size_t    concurrency_ = 0,
+        std::ptrdiff_t block_       = 0) noexcept
+        : concurrency{concurrency_}
+        , block{block_}
+    {}
 };
 
-template<typename Size>
-struct tag<Size, wchar_t const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
+HIPONY_ENUMERATE_MAYBE_UNUSED HIPONY_ENUMERATE_CONSTEXPR auto const self_scheduling
+    = self_scheduling_policy{};
+
+struct read_ahead_policy {
+    std::size_t capacity;
+
+    HIPONY_ENUMERATE_CONSTEXPR explicit read_ahead_policy(std::size_t capacity_ = 0) noexcept
+        : capacity{capacity_}
+    {}
 };
 
-#if HIPONY_ENUMERATE_HAS_CHAR8
+HIPONY_ENUMERATE_MAYBE_UNUSED HIPONY_ENUMERATE_CONSTEXPR auto const read_ahead
+    = read_ahead_policy{};
 
-template<typename Size>
-struct tag<Size, char8_t const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
+namespace detail {
+
+inline auto concurrency(std::size_t requested) noexcept -> std::size_t
+{
+    if (requested != 0) {
+        return requested;
+    }
+    auto const hardware = std::thread::hardware_concurrency();
+    return hardware != 0 ? hardware : 1;
+}
+
+inline auto grain(std::ptrdiff_t requested, std::ptrdiff_t size, std::size_t concurrency) noexcept
+    -> std::ptrdiff_t
+{
+    if (requested > 0) {
+        return requested;
+    }
+    // NOTE: Several tasks per thread leave room for stealing without drowning in bookkeeping
+    auto const tasks = static_cast<std::ptrdiff_t>(concurrency) * 32;
+    return size / tasks > 0 ? size / tasks : 1;
+}
+
+class worker_errors {
+    std::atomic<bool>  _stop{false};
+    std::mutex         _mutex;
+    std::exception_ptr _error;
+
+public:
+    HIPONY_ENUMERATE_NODISCARD auto stopped() const noexcept -> bool
+    {
+        return _stop.load(std::memory_order_relaxed);
+    }
+
+    void capture()
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        if (!_error) {
+            _error = std::current_exception();
+        }
+        _stop.store(true, std::memory_order_relaxed);
+    }
+
+    void rethrow() const
+    {
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+    }
 };
 
-#endif
+// NOTE: Joins on every exit path, a joinable std::thread destructor terminates the process
+struct worker_threads {
+    std::vector<std::thread> threads;
 
-template<typename Size>
-struct tag<Size, char16_t const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
+    worker_threads()                                         = default;
+    worker_threads(worker_threads const&)                    = delete;
+    auto operator=(worker_threads const&) -> worker_threads& = delete;
+
+    ~worker_threads()
+    {
+        for (auto& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
 };
 
-template<typename Size>
-struct tag<Size, char32_t const*, typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
+// NOTE: The calling thread takes part as worker 0. Workers must not throw, already started ones
+// drain the remaining work when spawning another thread fails
+template<typename Worker>
+inline void run_workers(std::size_t concurrency, Worker worker)
+{
+    worker_threads pool;
+    pool.threads.reserve(concurrency - 1);
+    for (std::size_t id = 1; id < concurrency; ++id) {
+        pool.threads.emplace_back([&worker, id] { worker(id); });
+    }
+    worker(0);
+}
+
+template<typename Iterator, bool RandomAccess = detail::is_random_access_iterator<Iterator>::value>
+class work_units {
+public:
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+
+private:
+    Iterator        _first;
+    difference_type _size;
+
+public:
+    work_units(Iterator first, Iterator last, difference_type /*grain*/)
+        : _first{first}
+        , _size{last - first}
+    {}
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> difference_type
+    {
+        return _size;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto at(difference_type index) const noexcept -> Iterator
+    {
+        return _first + index;
+    }
 };
 
-template<typename Size, Size N>
-struct tag<Size, char const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
+// NOTE: Forward ranges are pre-walked once, each unit is then a block of `grain` elements
+
+template<typename Iterator>
+class work_units<Iterator, false> {
+public:
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+
+private:
+    std::vector<Iterator> _marks;
+
+public:
+    work_units(Iterator first, Iterator last, difference_type grain)
+    {
+        _marks.push_back(first);
+        while (first != last) {
+            for (difference_type i = 0; i < grain && first != last; ++i) {
+                ++first;
+            }
+            _marks.push_back(first);
+        }
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto size() const noexcept -> difference_type
+    {
+        return static_cast<difference_type>(_marks.size()) - 1;
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto at(difference_type index) const noexcept -> Iterator
+    {
+        return _marks[static_cast<std::size_t>(index)];
+    }
 };
 
-template<typename Size, Size N>
-struct tag<Size, wchar_t const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
+template<typename Units, typename F>
+class work_stealing_executor {
+public:
+    using difference_type = typename Units::difference_type;
+
+private:
+    struct task {
+        difference_type first;
+        difference_type last;
+    };
+
+    struct queue {
+        std::mutex       mutex;
+        std::deque<task> tasks;
+    };
+
+    Units const&                 _units;
+    F&                           _f;
+    difference_type              _grain;
+    std::vector<queue>           _queues;
+    std::atomic<difference_type> _remaining;
+    std::atomic<std::size_t>     _queued{0};
+    std::atomic<std::size_t>     _sleeping{0};
+    std::mutex                   _idle_mutex;
+    std::condition_variable      _idle;
+    detail::worker_errors        _errors;
+
+public:
+    work_stealing_executor(
+        Units const&    units,
+        F&              f,
+        difference_type grain,
+        std::size_t     concurrency)
+        : _units{units}
+        , _f{f}
+        , _grain{grain}
+        , _queues(concurrency)
+        , _remaining{units.size()}
+    {}
+
+    void run()
+    {
+        if (_units.size() == 0) {
+            return;
+        }
+        push(0, {0, _units.size()});
+        detail::run_workers(_queues.size(), [this](std::size_t id) { work(id); });
+        _errors.rethrow();
+    }
+
+private:
+    void work(std::size_t id)
+    {
+        auto current = task{};
+        while (!done()) {
+            if (pop(id, current) || steal(id, current)) {
+                execute(id, current);
+            } else {
+                park();
+            }
+        }
+    }
+
+    HIPONY_ENUMERATE_NODISCARD auto done() const noexcept -> bool
+    {
+        return _remaining.load(std::memory_order_acquire) <= 0 || _errors.stopped();
+    }
+
+    // NOTE: Idle thieves sleep until a task is queued or the loop ends instead of spinning
+    void park()
+    {
+        std::unique_lock<std::mutex> lock{_idle_mutex};
+        _sleeping.fetch_add(1);
+        _idle.wait(lock, [this] { return _queued.load() > 0 || done(); });
+        _sleeping.fetch_sub(1);
+    }
+
+    void wake(bool all)
+    {
+        if (_sleeping.load() == 0) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock{_idle_mutex};
+        }
+        if (all) {
+            _idle.notify_all();
+        } else {
+            _idle.notify_one();
+        }
+    }
+
+    void execute(std::size_t id, task current)
+    {
+        // NOTE: Halves go to the back of our own queue, thieves take the largest ones from the
+        // front
+        while (current.last - current.first > _grain) {
+            auto const middle = current.first + (current.last - current.first) / 2;
+            push(id, {middle, current.last});
+            current.last = middle;
+        }
+        auto failed = false;
+        try {
+            for (auto it = _units.at(current.first), last = _units.at(current.last); it != last;
+                 ++it) {
+                _f(*it);
+            }
+        } catch (...) {
+            _errors.capture();
+            failed = true;
+        }
+        auto const size = current.last - current.first;
+        if (_remaining.fetch_sub(size, std::memory_order_acq_rel) == size || failed) {
+            wake(true);
+        }
+    }
+
+    void push(std::size_t id, task value)
+    {
+        {
+            std::lock_guard<std::mutex> lock{_queues[id].mutex};
+            _queues[id].tasks.push_back(value);
+            _queued.fetch_add(1);
+        }
+        wake(false);
+    }
+
+    auto pop(std::size_t id, task& value) -> bool
+    {
+        std::lock_guard<std::mutex> lock{_queues[id].mutex};
+        if (_queues[id].tasks.empty()) {
+            return false;
+        }
+        value = _queues[id].tasks.back();
+        _queues[id].tasks.pop_back();
+        _queued.fetch_sub(1);
+        return true;
+    }
+
+    auto steal(std::size_t id, task& value) -> bool
+    {
+        for (std::size_t offset = 1; offset < _queues.size(); ++offset) {
+            auto&                       victim = _queues[(id + offset) % _queues.size()];
+            std::lock_guard<std::mutex> lock{victim.mutex};
+            if (!victim.tasks.empty()) {
+                value = victim.tasks.front();
+                victim.tasks.pop_front();
+                _queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
 };
 
-#if HIPONY_ENUMERATE_HAS_CHAR8
+template<typename Range, typename F>
+inline void for_each(work_stealing_policy const& policy, Range& range, F& f)
+{
+    using iterator        = detail::range_iterator_t<Range>;
+    using units_type      = detail::work_units<iterator>;
+    using difference_type = typename units_type::difference_type;
+
+    auto const first       = range.begin();
+    auto const last        = detail::common_end(range);
+    auto const concurrency = detail::concurrency(policy.concurrency);
+    auto const size        = static_cast<difference_type>(std::distance(first, last));
+    auto const grain       = static_cast<difference_type>(detail::grain(
+        static_cast<std::ptrdiff_t>(policy.grain), static_cast<std::ptrdiff_t>(size), concurrency));
+
+    auto const units = units_type{first, last, grain};
+    // NOTE: Pre-walked units are already blocks of `grain` elements
+    auto const leaf = detail::is_random_access_iterator<iterator>::value ? grain : 1;
+    detail::work_stealing_executor<units_type, F>{units, f, leaf, concurrency}.run();
+}
 
-template<typename Size, Size N>
-struct tag<Size, char8_t const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
-};
+template<typename Iterator, typename F>
+class self_scheduling_executor {
+public:
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
 
-#endif
+private:
+    Iterator                     _first;
+    difference_type              _size;
+    difference_type              _block;
+    difference_type              _concurrency;
+    F&                           _f;
+    std::atomic<difference_type> _next{0};
+    detail::worker_errors        _errors;
 
-template<typename Size, Size N>
-struct tag<Size, char16_t const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
-};
+public:
+    self_scheduling_executor(
+        Iterator        first,
+        difference_type size,
+        difference_type block,
+        std::size_t     concurrency,
+        F&              f)
+        : _first{first}
+        , _size{size}
+        , _block{block}
+        , _concurrency{static_cast<difference_type>(concurrency)}
+        , _f{f}
+    {}
 
-template<typename Size, Size N>
-struct tag<Size, char32_t const[N], typename detail::enable_if_t<std::is_integral<Size>::value>> {
-    using type = string_tag_t;
-};
+    void run()
+    {
+        if (_size == 0) {
+            return;
+        }
+        detail::run_workers(
+            static_cast<std::size_t>(_concurrency), [this](std::size_t /*id*/) { work(); });
+        _errors.rethrow();
+    }
 
-template<typename Size, typename T, Size N>
-struct tag<
-    Size,
-    T[N],
-    typename detail::enable_if_t<
-        std::is_integral<Size>::value && !detail::is_string_literal<T>::value>> {
-    using type = array_tag_t;
+private:
+    void work()
+    {
+        auto first = difference_type{};
+        auto last  = difference_type{};
+        while (!_errors.stopped() && claim(first, last)) {
+            try {
+                for (auto it = _first + first, end = _first + last; it != end; ++it) {
+                    _f(*it);
+                }
+            } catch (...) {
+                _errors.capture();
+            }
+        }
+    }
+
+    auto claim(difference_type& first, difference_type& last) -> bool
+    {
+        if (_block > 0) {
+            first = _next.fetch_add(_block, std::memory_order_relaxed);
+            if (first >= _size) {
+                return false;
+            }
+            last = (std::min)(first + _block, _size);
+            return true;
+        }
+        // NOTE: Guided schedule, blocks shrink with the remaining work down to a single element
+        auto current = _next.load(std::memory_order_relaxed);
+        do {
+            if (current >= _size) {
+                return false;
+            }
+            auto const block = (_size - current) / (2 * _concurrency);
+            last             = current + (block > 0 ? block : 1);
+        } while (!_next.compare_exchange_weak(current, last, std::memory_order_relaxed));
+        first = current;
+        return true;
+    }
 };
 
-template<typename Size, typename T, Size N, typename TSize>
-struct tag<
-    Size,
-    T[N],
-    typename detail::enable_if_t<
-        std::is_integral<Size>::value && std::is_convertible<TSize, Size>::value>,
-    TSize> {
+} // namespace detail
+
+template<typename Range, typename F>
+inline void for_each(work_stealing_policy const& policy, Range&& range, F f)
+{
+    detail::for_each(policy, range, f);
+}
+
+template<typename Range, typename F>
+inline void for_each(self_scheduling_policy const& policy, Range&& range, F f)
+{
     static_assert(
-        !detail::is_narrow_convertible<TSize, Size>::value,
-        "Narrowing conversions for Size are not allowed. Either cast it explicitly or use the "
-        "`_as<Size>` overload.");
-    using type = array_tag_t;
-};
+        detail::is_random_access_enumerate<detail::remove_ref_t<Range>>::value,
+        "Self-scheduling requires a random-access common range");
+    using iterator        = detail::range_iterator_t<detail::remove_ref_t<Range>>;
+    using difference_type = typename std::iterator_traits<iterator>::difference_type;
 
-#if HIPONY_ENUMERATE_HAS_AGGREGATES
+    auto const first = range.begin();
+    auto const size  = static_cast<difference_type>(range.end() - first);
+    auto const block = static_cast<difference_type>(policy.block > 0 ? policy.block : 0);
+    detail::self_scheduling_executor<iterator, F>{
+        first, size, block, detail::concurrency(policy.concurrency), f}
+        .run();
+}
 
-template<typename Size, typename T>
-struct tag<
-    Size,
-    T,
-    typename detail::enable_if_t<
-        std::is_aggregate<T>::value && !std::is_polymorphic<T>::value && !detail::is_tuple<T>::value
-        && !std::is_array<T>::value>> {
-    using type = aggregate_tag_t;
-};
+namespace detail {
 
-#endif
+// NOTE: Single-producer single-consumer ring. The positions only grow and are published with
+// atomics, the mutex is only taken to sleep when the ring is full or empty and to wake the sleeper
 
-template<typename... Ts>
-using tag_t = typename tag<Ts...>::type;
+template<typename Iterator, typename Sentinel>
+class read_ahead_state {
+public:
+    using value_type = detail::remove_cvref_t<decltype(*std::declval<Iterator&>())>;
 
-template<typename Tag = void, typename...>
-struct dispatch;
+private:
+    std::vector<value_type>  _ring;
+    std::atomic<std::size_t> _head{0};
+    std::atomic<std::size_t> _tail{0};
+    std::atomic<bool>        _done{false};
+    std::atomic<bool>        _stop{false};
+    std::atomic<bool>        _producer_sleeping{false};
+    std::atomic<bool>        _consumer_sleeping{false};
+    std::mutex               _mutex;
+    std::condition_variable  _wake;
+    std::exception_ptr       _error;
+    std::thread              _producer;
+
+    template<typename Predicate>
+    void sleep(std::atomic<bool>& sleeping, Predicate ready)
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        sleeping.store(true);
+        _wake.wait(lock, ready);
+        sleeping.store(false);
+    }
 
-template<typename Size, typename... Ts>
-struct dispatch<detail::variadic_tuple_tag_t, Size, Ts...> {
-    using type = detail::tuple_wrapper<Size, std::tuple<detail::remove_rref_t<Ts>...>>;
-};
+    void wake(std::atomic<bool> const& sleeping)
+    {
+        if (sleeping.load()) {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _wake.notify_all();
+        }
+    }
 
-template<typename Size, typename T, typename... Ts>
-struct dispatch<detail::variadic_array_tag_t, Size, T, Ts...> {
-    using type = detail::range<Size, detail::array<detail::remove_rref_t<T>, sizeof...(Ts) + 1>>;
-};
+    void produce(Iterator first, Sentinel last)
+    {
+        try {
+            auto const capacity = _ring.size();
+            for (auto tail = std::size_t{0}; !(first == last); ++first, ++tail) {
+                if (tail - _head.load() == capacity) {
+                    sleep(_producer_sleeping, [&] {
+                        return tail - _head.load() != capacity || _stop.load();
+                    });
+                }
+                if (_stop.load()) {
+                    break;
+                }
+                _ring[tail % capacity] = *first;
+                _tail.store(tail + 1);
+                wake(_consumer_sleeping);
+            }
+        } catch (...) {
+            _error = std::current_exception();
+        }
+        _done.store(true);
+        wake(_consumer_sleeping);
+    }
 
-template<typename Size, typename T, typename T1>
-struct dispatch<detail::iterator_pointer_tag_t, Size, T, T1> {
-    using type
-        = detail::range<Size, detail::span<detail::remove_ref_t<T>, detail::remove_ref_t<T1>, Size>>;
-};
+public:
+    read_ahead_state(Iterator first, Sentinel last, std::size_t capacity)
+        : _ring(capacity)
+    {
+        _producer = std::thread{[this, first, last] { produce(first, last); }};
+    }
 
-template<typename Size, typename T, typename Sentinel>
-struct dispatch<detail::iterator_tag_t, Size, T, Sentinel> {
-    using type = detail::
-        range<Size, detail::span<detail::remove_ref_t<T>, detail::remove_ref_t<Sentinel>, Size>>;
-};
+    read_ahead_state(read_ahead_state const&) = delete;
+    auto operator=(read_ahead_state const&) -> read_ahead_state& = delete;
 
-template<typename Size, typename T>
-struct dispatch<detail::container_tag_t, Size, T> {
-    using type = detail::range<Size, detail::remove_rref_t<T>>;
-};
+    ~read_ahead_state()
+    {
+        _stop.store(true);
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _wake.notify_all();
+        }
+        _producer.join();
+    }
 
-template<typename Size, typename T>
-struct dispatch<detail::container_tag_t, Size, T&> {
-    using type = detail::view<Size, T>;
-};
+    // NOTE: Waits until the element at the head is produced, false once the source is exhausted
+    auto available() -> bool
+    {
+        auto const head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load()) {
+            sleep(_consumer_sleeping, [&] { return head != _tail.load() || _done.load(); });
+            if (head == _tail.load()) {
+                if (_error) {
+                    std::rethrow_exception(_error);
+                }
+                return false;
+            }
+        }
+        return true;
+    }
 
-template<typename Size, typename T, typename TSize>
-struct dispatch<detail::container_size_tag_t, Size, T, TSize> {
-    using type = detail::limited_range<Size, detail::remove_rref_t<T>>;
-};
+    HIPONY_ENUMERATE_NODISCARD auto front() noexcept -> value_type&
+    {
+        return _ring[_head.load(std::memory_order_relaxed) % _ring.size()];
+    }
 
-template<typename Size, typename T, typename TSize>
-struct dispatch<detail::container_size_tag_t, Size, T&, TSize> {
-    using type = detail::limited_view<Size, T>;
+    void pop()
+    {
+        _head.store(_head.load(std::memory_order_relaxed) + 1);
+        wake(_producer_sleeping);
+    }
 };
 
-template<typename Size, typename T>
-struct dispatch<detail::tuple_tag_t, Size, T> {
-    using type = detail::tuple_wrapper<Size, detail::remove_rref_t<T>, detail::remove_cvref_t<T>>;
-};
+template<typename Iterator, typename Sentinel>
+class read_ahead_iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = typename read_ahead_state<Iterator, Sentinel>::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type*;
+    using reference         = value_type&;
 
-template<typename Size, typename T, typename TSize>
-struct dispatch<detail::pointer_tag_t, Size, T, TSize> {
-    using type
-        = detail::range<Size, detail::span<detail::remove_ref_t<T>, detail::remove_ref_t<T>, Size>>;
-};
+private:
+    read_ahead_state<Iterator, Sentinel>* _state = nullptr;
 
-template<typename Size, typename T>
-struct dispatch<detail::string_tag_t, Size, T> {
-    using type = detail::range<Size, detail::zstring_view<detail::decay_t<T>>>;
-};
+public:
+    read_ahead_iterator() = default;
 
-template<typename Size, typename T, Size N>
-struct dispatch<detail::array_tag_t, Size, T (&)[N]> {
-    using type = detail::
-        range<Size, detail::span<detail::remove_ref_t<T>*, detail::remove_ref_t<T>*, Size, N>>;
-};
+    read_ahead_iterator(read_ahead_state<Iterator, Sentinel>* state) noexcept
+        : _state{state}
+    {}
 
-template<typename Size, typename T, Size N, typename TSize>
-struct dispatch<detail::array_tag_t, Size, T (&)[N], TSize> {
-    using type
-        = detail::range<Size, detail::span<detail::remove_ref_t<T>*, detail::remove_ref_t<T>*, Size>>;
-};
+    HIPONY_ENUMERATE_NODISCARD auto operator*() const noexcept -> reference
+    {
+        return _state->front();
+    }
 
-#if HIPONY_ENUMERATE_HAS_AGGREGATES
+    auto operator++() -> read_ahead_iterator&
+    {
+        _state->pop();
+        if (!_state->available()) {
+            _state = nullptr;
+        }
+        return *this;
+    }
 
-template<typename Size, typename T>
-struct dispatch<detail::aggregate_tag_t, Size, T> {
-    using type = detail::aggregate_wrapper<Size, T>;
-};
+    void operator++(int)
+    {
+        ++(*this);
+    }
 
-#endif
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator==(read_ahead_iterator const& lhs, read_ahead_iterator const& rhs) noexcept -> bool
+    {
+        return lhs._state == rhs._state;
+    }
 
-template<typename... Ts>
-using dispatch_t = typename dispatch<Ts...>::type;
+    HIPONY_ENUMERATE_NODISCARD friend auto
+    operator!=(read_ahead_iterator const& lhs, read_ahead_iterator const& rhs) noexcept -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
 
-} // namespace detail
+template<typename Iterator, typename Sentinel>
+struct read_ahead_view {
+    using value_type     = typename read_ahead_state<Iterator, Sentinel>::value_type;
+    using iterator       = read_ahead_iterator<Iterator, Sentinel>;
+    using const_iterator = iterator;
 
-template<typename T, typename... Ts>
-HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
-enumerate(T&& t, Ts&&... ts) noexcept -> detail::dispatch_t<
-    detail::tag_t<
-        detail::size_t<detail::void_t<>, detail::remove_cvref_t<T>>,
-        detail::sanitize_t<T>,
-        detail::void_t<>,
-        detail::remove_cvref_t<Ts>...>,
-    detail::size_t<detail::void_t<>, detail::remove_cvref_t<T>>,
-    T,
-    Ts...>
-{
-    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
-}
+    std::unique_ptr<read_ahead_state<Iterator, Sentinel>> state;
 
-template<typename Size, typename T, typename... Ts>
-HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
-enumerate_as(T&& t, Ts&&... ts) noexcept -> detail::dispatch_t<
-    detail::tag_t<
-        detail::size_t<Size, detail::remove_cvref_t<T>>,
-        detail::sanitize_t<T>,
-        detail::void_t<>,
-        detail::remove_cvref_t<Ts>...>,
-    detail::size_t<Size, detail::remove_cvref_t<T>>,
-    T,
-    Ts...>
-{
-    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
-}
+    HIPONY_ENUMERATE_NODISCARD auto begin() const -> const_iterator
+    {
+        if (!state->available()) {
+            return {};
+        }
+        return {state.get()};
+    }
 
-using HIPONY_ENUMERATE_NAMESPACE::as_tuple_tag_t;
+    HIPONY_ENUMERATE_NODISCARD auto end() const noexcept -> const_iterator
+    {
+        return {};
+    }
+};
 
-template<typename T, typename... Ts>
-HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
-enumerate(as_tuple_tag_t /*_*/, T&& t, Ts&&... ts) noexcept -> detail::dispatch_t<
-    detail::variadic_tuple_tag_t,
-    detail::size_t<detail::void_t<>, detail::remove_cvref_t<T>>,
-    T,
-    Ts...>
-{
-    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
-}
+template<typename Size, typename Iterator, typename Sentinel>
+using read_ahead_t = typename detail::enable_if_t<
+    detail::is_iterator<Iterator>::value,
+    detail::range<detail::size_t<Size, Iterator>, detail::read_ahead_view<Iterator, Sentinel>>>;
 
-template<typename Size, typename T, typename... Ts>
-HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
-enumerate_as(as_tuple_tag_t /*_*/, T&& t, Ts&&... ts) noexcept -> detail::
-    dispatch_t<detail::variadic_tuple_tag_t, detail::size_t<Size, detail::remove_cvref_t<T>>, T, Ts...>
+template<typename Iterator, typename Sentinel>
+inline auto make_read_ahead(read_ahead_policy const& policy, Iterator first, Sentinel last)
+    -> std::unique_ptr<read_ahead_state<Iterator, Sentinel>>
 {
-    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
+    auto const capacity = policy.capacity > 0 ? policy.capacity : std::size_t{1024};
+    return std::unique_ptr<read_ahead_state<Iterator, Sentinel>>(
+        new read_ahead_state<Iterator, Sentinel>(
+            static_cast<Iterator&&>(first), static_cast<Sentinel&&>(last), capacity));
 }
 
-using HIPONY_ENUMERATE_NAMESPACE::as_array_tag_t;
+} // namespace detail
 
-template<typename T, typename... Ts>
-HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
-enumerate(as_array_tag_t /*_*/, T&& t, Ts&&... ts) noexcept -> detail::dispatch_t<
-    detail::variadic_array_tag_t,
-    detail::size_t<detail::void_t<>, detail::remove_cvref_t<T>>,
-    T,
-    Ts...>
+// NOTE: A helper thread pulls elements from the source into a bounded ring while the loop body
+// runs. The elements are copied out of the source, leaving the loop early stops the helper
+
+template<typename Iterator, typename Sentinel>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate(read_ahead_policy const& policy, Iterator first, Sentinel last)
+    -> detail::read_ahead_t<detail::void_t<>, Iterator, Sentinel>
 {
-    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
+    return {{detail::make_read_ahead(
+        policy, static_cast<Iterator&&>(first), static_cast<Sentinel&&>(last))}};
 }
 
-template<typename Size, typename T, typename... Ts>
-HIPONY_ENUMERATE_NODISCARD HIPONY_ENUMERATE_CONSTEXPR inline auto
-enumerate_as(as_array_tag_t /*_*/, T&& t, Ts&&... ts) noexcept -> detail::
-    dispatch_t<detail::variadic_array_tag_t, detail::size_t<Size, detail::remove_cvref_t<T>>, T, Ts...>
+template<typename Size, typename Iterator, typename Sentinel>
+HIPONY_ENUMERATE_NODISCARD inline auto
+enumerate_as(read_ahead_policy const& policy, Iterator first, Sentinel last)
+    -> detail::read_ahead_t<Size, Iterator, Sentinel>
 {
-    return {{static_cast<T&&>(t), static_cast<Ts&&>(ts)...}};
+    return {{detail::make_read_ahead(
+        policy, static_cast<Iterator&&>(first), static_cast<Sentinel&&>(last))}};
 }
 
+#endif
+
 #if HIPONY_ENUMERATE_HAS_RANGES
 
 template<typename Size = detail::void_t<>>
@@ -1888,6 +7065,49 @@ using hipony_enumerate::enumerate_as;
 
 #endif
 
+using hipony_enumerate::blocked;
+using hipony_enumerate::chunks;
+using hipony_enumerate::code_point;
+using hipony_enumerate::seek;
+using hipony_enumerate::split;
+using hipony_enumerate::until;
+
+#if HIPONY_ENUMERATE_HAS_STRING_VIEW
+using hipony_enumerate::csv_dialect;
+using hipony_enumerate::csv_field;
+using hipony_enumerate::enumerate_lines;
+using hipony_enumerate::enumerate_lines_as;
+using hipony_enumerate::line_index;
+#endif
+
+#if HIPONY_ENUMERATE_HAS_BYTE
+using hipony_enumerate::byte_span;
+using hipony_enumerate::fixed_prefix;
+using hipony_enumerate::length_record;
+using hipony_enumerate::varint_prefix;
+#endif
+
+#if HIPONY_ENUMERATE_HAS_FILES
+using hipony_enumerate::block_policy;
+using hipony_enumerate::file_blocks;
+using hipony_enumerate::map_policy;
+using hipony_enumerate::mapped_array;
+using hipony_enumerate::mapped_file;
+using hipony_enumerate::prefetch_policy;
+using hipony_enumerate::prefetch_stats;
+using hipony_enumerate::shared_array;
+#endif
+
+#if HIPONY_ENUMERATE_HAS_PARALLEL
+using hipony_enumerate::for_each;
+using hipony_enumerate::read_ahead;
+using hipony_enumerate::read_ahead_policy;
+using hipony_enumerate::self_scheduling;
+using hipony_enumerate::self_scheduling_policy;
+using hipony_enumerate::work_stealing;
+using hipony_enumerate::work_stealing_policy;
+#endif
+
 } // namespace HIPONY_ENUMERATE_NAMESPACE
 
 #endif
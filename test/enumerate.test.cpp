@@ -7,12 +7,36 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#if HIPONY_ENUMERATE_HAS_EXECUTION
+#include <execution>
+#endif
+
+#if defined(HIPONY_ENUMERATE_TEST_TBB)
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
+#if HIPONY_ENUMERATE_HAS_FILES
+#include <sys/wait.h>
+#endif
+
 namespace HIPONY_ENUMERATE_NAMESPACE {
 
 namespace {
@@ -80,12 +104,115 @@ TEST_CASE("as_tuple")
         });
         REQUIRE(counter == 3);
     }
+    SECTION("homogeneous")
+    {
+        auto counter = 0;
+        auto range   = enumerate(as_tuple, 0., 10., 20., 30.);
+        range.each([&](auto index, auto& value) {
+            assert_same<decltype(value), double&>();
+
+            REQUIRE(static_cast<double>(index) * 10. == value);
+            ++counter;
+        });
+        REQUIRE(counter == 4);
+        REQUIRE(range.each_until([](auto index, auto& /*value*/) { return index == 2; }));
+        REQUIRE(range.visit_at(3, [](auto /*index*/, auto& value) { return value; }) == 30.);
+    }
 }
 
 #endif // HIPONY_ENUMERATE_CPP14_OR_GREATER
 
+TEST_CASE("as_tuple homogeneous")
+{
+    SECTION("for-range")
+    {
+        auto counter = 0;
+        auto range   = enumerate(as_tuple, 0, 10, 20, 30, 40);
+        static_assert(
+            std::is_base_of<
+                std::random_access_iterator_tag,
+                std::iterator_traits<decltype(range.begin())>::iterator_category>::value,
+            "Homogeneous tuples should be random-access");
+        for (auto&& item : range) {
+            assert_same<std::size_t, decltype(item.index)>();
+            assert_same<int&, decltype(item.value)>();
+
+            REQUIRE(item.index * 10 == item.value);
+            ++counter;
+        }
+        REQUIRE(counter == 5);
+        REQUIRE(range.end() - range.begin() == 5);
+    }
+    SECTION("lvalues")
+    {
+        auto lhs = 0;
+        auto rhs = 0;
+        for (auto&& item : enumerate(as_tuple, lhs, rhs)) {
+            assert_same<int&, decltype(item.value)>();
+
+            item.value = static_cast<int>(item.index) + 10;
+        }
+        REQUIRE(lhs == 10);
+        REQUIRE(rhs == 11);
+    }
+    SECTION("for-range as int")
+    {
+        auto counter = 0;
+        for (auto&& item : enumerate_as<int>(as_tuple, 0, 10, 20)) {
+            assert_same<int, decltype(item.index)>();
+
+            REQUIRE(item.index * 10 == item.value);
+            ++counter;
+        }
+        REQUIRE(counter == 3);
+    }
+}
+
 TEST_CASE("as_array")
 {
+    SECTION("lvalues")
+    {
+        auto lhs = std::string{"lhs"};
+        auto rhs = std::string{"rhs"};
+        for (auto&& item : enumerate(as_array, lhs, rhs)) {
+            assert_same<std::string&, decltype(item.value)>();
+
+            item.value += std::to_string(item.index);
+        }
+        REQUIRE(lhs == "lhs0");
+        REQUIRE(rhs == "rhs1");
+    }
+    SECTION("const lvalues")
+    {
+        auto const lhs   = std::string{"lhs"};
+        auto const rhs   = std::string{"rhs"};
+        auto const range = enumerate(as_array, lhs, rhs);
+        assert_same<std::string const&, decltype((*range.begin()).value)>();
+        REQUIRE(&(*range.begin()).value == &lhs);
+        REQUIRE(&(*(range.begin() + 1)).value == &rhs);
+        REQUIRE(range.end() - range.begin() == 2);
+    }
+    SECTION("rvalues are moved")
+    {
+        auto counter = 0;
+        auto range = enumerate(
+            as_array, std::unique_ptr<int>{new int{0}}, std::unique_ptr<int>{new int{10}});
+        for (auto&& item : range) {
+            assert_same<std::unique_ptr<int>&, decltype(item.value)>();
+
+            REQUIRE(static_cast<int>(item.index) * 10 == *item.value);
+            ++counter;
+        }
+        REQUIRE(counter == 2);
+    }
+    SECTION("mixed")
+    {
+        auto lhs   = std::string{"lhs"};
+        auto range = enumerate(as_array, lhs, std::string{"rhs"});
+        (*range.begin()).value += "0";
+        REQUIRE(lhs == "lhs");
+        REQUIRE((*(range.begin() + 1)).value == "rhs");
+    }
     SECTION("for-range")
     {
         auto counter = 0;
@@ -257,6 +384,26 @@ TEST_CASE("iterator_tag_t")
         }
         REQUIRE(counter == 3);
     }
+    SECTION("until")
+    {
+        auto      counter = 0;
+        int const array[] = {0, 10, 20, -1, 40};
+        for (auto&& item : enumerate(&array[0], until(-1))) {
+            assert_same<int const&, decltype(item.value)>();
+
+            REQUIRE(&array[item.index] == &item.value);
+            ++counter;
+        }
+        REQUIRE(counter == 3);
+
+        auto const list = std::list<int>({0, 10, 20, 30, 40});
+        counter         = 0;
+        for (auto&& item : enumerate_as<int>(list.begin(), until(30))) {
+            REQUIRE(item.index * 10 == item.value);
+            ++counter;
+        }
+        REQUIRE(counter == 3);
+    }
 #endif
 }
 
@@ -365,7 +512,8 @@ TEST_CASE("container_tag_t")
                 assert_same<int, decltype(item.index)>();
                 assert_same<decltype(array)::value_type const&, decltype(item.value)>();
 
-                auto const index = array.size() - (item.index + 1);
+                auto const index = array.size() - (counter + 1);
+                REQUIRE(item.index == static_cast<int>(index));
                 REQUIRE(&array[index] == &item.value);
                 REQUIRE(index * 10 == item.value);
                 ++counter;
@@ -477,7 +625,8 @@ TEST_CASE("container_tag_t")
                 assert_same<int, decltype(item.index)>();
                 assert_same<decltype(vector)::value_type const&, decltype(item.value)>();
 
-                auto const index = vector.size() - (item.index + 1);
+                auto const index = vector.size() - (counter + 1);
+                REQUIRE(item.index == static_cast<int>(index));
                 REQUIRE(&vector[index] == &item.value);
                 REQUIRE(index * 10 == item.value);
                 ++counter;
@@ -589,7 +738,8 @@ TEST_CASE("container_tag_t")
                 assert_same<int, decltype(item.index)>();
                 assert_same<decltype(string)::value_type const&, decltype(item.value)>();
 
-                auto const index = string.size() - (item.index + 1);
+                auto const index = string.size() - (counter + 1);
+                REQUIRE(item.index == static_cast<int>(index));
                 REQUIRE(&string[index] == &item.value);
                 REQUIRE(index + '0' == item.value);
                 ++counter;
@@ -696,8 +846,26 @@ TEST_CASE("container_tag_t")
                 assert_same<int, decltype(item.index)>();
                 assert_same<decltype(list)::value_type const&, decltype(item.value)>();
 
-                auto const index = list.size() - (item.index + 1);
+                auto const index = list.size() - (counter + 1);
+                REQUIRE(item.index == static_cast<int>(index));
+                REQUIRE(index * 10 == item.value);
+                ++counter;
+            }
+            REQUIRE(counter == list.size());
+        }
+        SECTION("ranges-reverse-iterators")
+        {
+            auto       counter  = 0;
+            auto       previous = 0;
+            auto const list     = std::list<int>({0, 10, 20, 30, 40});
+            for (auto&& item :
+                 enumerate_as<int>(list.begin(), list.end()) | std::ranges::views::reverse) {
+                auto const index = list.size() - (counter + 1);
+                if (counter > 0) {
+                    REQUIRE(item.index == previous - 1);
+                }
                 REQUIRE(index * 10 == item.value);
+                previous = item.index;
                 ++counter;
             }
             REQUIRE(counter == list.size());
@@ -809,7 +977,8 @@ TEST_CASE("container_size_tag_t")
                 assert_same<int, decltype(item.index)>();
                 assert_same<decltype(array)::value_type const&, decltype(item.value)>();
 
-                auto const index = size - (item.index + 1);
+                auto const index = size - (counter + 1);
+                REQUIRE(item.index == index);
                 REQUIRE(&array[index] == &item.value);
                 REQUIRE(index * 10 == item.value);
                 ++counter;
@@ -983,7 +1152,8 @@ TEST_CASE("container_size_tag_t")
                 assert_same<int, decltype(item.index)>();
                 assert_same<decltype(vector)::value_type const&, decltype(item.value)>();
 
-                auto const index = size - (item.index + 1);
+                auto const index = size - (counter + 1);
+                REQUIRE(item.index == index);
                 REQUIRE(&vector[index] == &item.value);
                 REQUIRE(index * 10 == item.value);
                 ++counter;
@@ -1421,6 +1591,44 @@ TEST_CASE("tuple_tag_t")
         });
         REQUIRE(counter == 3);
     }
+    SECTION("each_until")
+    {
+        auto       counter = 0;
+        auto const tuple   = std::make_tuple(0, 1., "str");
+        auto const found   = enumerate(tuple).each_until([&](auto index, auto& /*value*/) {
+            ++counter;
+            return index == 1;
+        });
+        REQUIRE(found);
+        REQUIRE(counter == 2);
+        REQUIRE(
+            !enumerate(tuple).each_until([](auto /*index*/, auto& /*value*/) { return false; }));
+    }
+    SECTION("visit_at")
+    {
+        auto tuple = std::make_tuple(0, 1., "str");
+        for (auto i = 0u; i < 3u; ++i) {
+            auto const index = enumerate(tuple).visit_at(i, [&](auto index, auto& value) {
+                assert_same<decltype(index), std::size_t>();
+                REQUIRE(index == i);
+                return index_of<typename std::decay<decltype(value)>::type>();
+            });
+            REQUIRE(index == static_cast<int>(i));
+        }
+        enumerate(tuple).visit_at(1, [](auto /*index*/, auto& value) { value = {}; });
+        REQUIRE(std::get<1>(tuple) == 0.);
+    }
+    SECTION("large")
+    {
+        auto const eight = std::make_tuple(0, 1, 2, 3, 4, 5, 6, 7);
+        auto const tuple = std::tuple_cat(eight, eight, eight, eight, eight, eight, eight, eight);
+        auto       sum   = 0;
+        enumerate(tuple).each([&](auto index, auto& value) {
+            REQUIRE(static_cast<int>(index % 8) == value);
+            sum += value;
+        });
+        REQUIRE(sum == 8 * 28);
+    }
 }
 
 #endif // HIPONY_ENUMERATE_CPP14_OR_GREATER
@@ -1802,161 +2010,1651 @@ TEST_CASE("string_tag_t")
     }
 }
 
-TEST_CASE("array_tag_t")
+#if HIPONY_ENUMERATE_CPP20_OR_GREATER
+TEST_CASE("zstring sentinel")
 {
-    // FIXME: The lifetime of the array prvalue will end after the function call returns
-    // SECTION("prvalue")
-    // {
-    //     auto counter = 0;
-    //     for (auto&& item : enumerate({0, 10, 20, 30, 40})) {
-    //         assert_same<std::size_t, decltype(item.index)>();
-    //         assert_same<int&, decltype(item.value)>();
-
-    //         REQUIRE(item.index * 10 == item.value);
-
-    //         ++counter;
-    //     }
-    //     REQUIRE(counter == 5);
-    // }
-    SECTION("for-range")
+    SECTION("end")
     {
-        auto counter     = 0;
-        int  container[] = {0, 10, 20, 30, 40};
-        for (auto&& item : enumerate(container)) {
-            assert_same<std::size_t, decltype(item.index)>();
-            assert_same<int&, decltype(item.value)>();
-
-            REQUIRE(&container[item.index] == &item.value);
-            REQUIRE(item.index * 10 == item.value);
-
+        auto const range = enumerate("01234");
+        static_assert(
+            !std::is_same<decltype(range.begin()), decltype(range.end())>::value,
+            "C-Strings should end with a sentinel");
+        auto counter = 0;
+        for (auto&& item : range) {
+            REQUIRE(static_cast<char>('0' + item.index) == item.value);
             ++counter;
         }
         REQUIRE(counter == 5);
     }
-    SECTION("const")
+    SECTION("null")
     {
-        auto      counter     = 0;
-        int const container[] = {0, 10, 20, 30, 40};
-        for (auto&& item : enumerate(container)) {
-            assert_same<std::size_t, decltype(item.index)>();
-            assert_same<int const&, decltype(item.value)>();
+        char const* str   = nullptr;
+        auto const  range = enumerate(str);
+        REQUIRE(range.begin() == range.end());
+    }
+    SECTION("split")
+    {
+        auto const parts   = split(enumerate("abcdef"), 2);
+        auto       counter = 0;
+        for (auto&& part : parts) {
+            for (auto&& item : part) {
+                REQUIRE(static_cast<char>('a' + item.index) == item.value);
+                ++counter;
+            }
+        }
+        REQUIRE(counter == 6);
+        REQUIRE((*parts[1].begin()).index == 3);
+        REQUIRE(chunks(enumerate("abcde"), 2).size() == 3);
+        REQUIRE(blocked(enumerate("abcde"), 2).size() == 5);
+    }
+}
+#endif
 
-            REQUIRE(&container[item.index] == &item.value);
-            REQUIRE(item.index * 10 == item.value);
+TEST_CASE("as_span")
+{
+    SECTION("for-range")
+    {
+        auto       counter = 0;
+        auto const str     = "01234";
+        auto const range   = enumerate(as_span, str);
+        static_assert(
+            std::is_base_of<
+                std::random_access_iterator_tag,
+                std::iterator_traits<decltype(range.begin())>::iterator_category>::value,
+            "Spans should be random-access");
+        for (auto&& item : range) {
+            assert_same<std::size_t, decltype(item.index)>();
+            assert_same<char const&, decltype(item.value)>();
 
+            REQUIRE(&str[item.index] == &item.value);
             ++counter;
         }
         REQUIRE(counter == 5);
+        REQUIRE(range.end() - range.begin() == 5);
     }
     SECTION("as int")
     {
-        auto      counter     = 0;
-        int const container[] = {0, 10, 20, 30, 40};
-        for (auto&& item : enumerate_as<int>(container)) {
+        auto counter = 0;
+        for (auto&& item : enumerate_as<int>(as_span, L"01234")) {
             assert_same<int, decltype(item.index)>();
-            assert_same<int const&, decltype(item.value)>();
-
-            REQUIRE(&container[item.index] == &item.value);
-            REQUIRE(item.index * 10 == item.value);
+            assert_same<wchar_t const&, decltype(item.value)>();
 
+            REQUIRE(static_cast<wchar_t>(L'0' + item.index) == item.value);
             ++counter;
         }
         REQUIRE(counter == 5);
     }
-#if HIPONY_ENUMERATE_HAS_RANGES && !defined(__clang__)
-    SECTION("ranges")
+    SECTION("char32_t")
     {
-        auto       counter     = 0;
-        int const  container[] = {0, 10, 20, 30, 40};
-        auto const range       = enumerate_as<int>(container);
-        for (auto&& item : range | std::ranges::views::take(3)) {
-            assert_same<int, decltype(item.index)>();
-            assert_same<int const&, decltype(item.value)>();
-
-            REQUIRE(&container[item.index] == &item.value);
-            REQUIRE(item.index * 10 == item.value);
+        auto const range = enumerate(as_span, U"01234");
+        REQUIRE(range.end() - range.begin() == 5);
+        REQUIRE((*(range.begin() + 4)).value == U'4');
+    }
+    SECTION("empty")
+    {
+        char const* str   = nullptr;
+        auto const  range = enumerate(as_span, str);
+        REQUIRE(range.begin() == range.end());
+        REQUIRE(enumerate(as_span, "").begin() == enumerate(as_span, "").end());
+    }
+    SECTION("split")
+    {
+        auto const str   = "0123456";
+        auto const parts = split(enumerate(as_span, str), 3);
+        REQUIRE((*parts[1].begin()).index == 3);
+        REQUIRE((*parts[2].begin()).value == '5');
+    }
+}
 
+TEST_CASE("as_code_points")
+{
+    SECTION("utf-8")
+    {
+        auto const str     = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+        auto       counter = 0;
+        for (auto&& item : enumerate(as_code_points, str)) {
+            assert_same<std::size_t, decltype(item.index)>();
+            assert_same<code_point, decltype(item.value)>();
             ++counter;
         }
-        REQUIRE(counter == 3);
+        REQUIRE(counter == 4);
+
+        auto const range = enumerate(as_code_points, str);
+        auto       it    = range.begin();
+        REQUIRE((*it).value.value == U'a');
+        ++it;
+        REQUIRE((*it).index == 1);
+        REQUIRE((*it).value.offset == 1);
+        REQUIRE((*it).value.value == 0xE9);
+        ++it;
+        REQUIRE((*it).value.offset == 3);
+        REQUIRE((*it).value.value == 0x20AC);
+        ++it;
+        REQUIRE((*it).value.offset == 6);
+        REQUIRE((*it).value.value == 0x1F600);
+        ++it;
+        REQUIRE(it == range.end());
     }
-    SECTION("ranges-pipe")
+    SECTION("ill-formed")
     {
-        auto      counter     = 0;
-        int const container[] = {0, 10, 20, 30, 40};
-        for (auto&& item : container | std::ranges::views::take(3) | enumerate_as<int>()) {
+        // NOTE: Truncated sequence, surrogate, overlong and a stray continuation byte
+        auto const str    = "\xE2\x82x\xED\xA0\x80\xC0\xAF\x80";
+        auto       values = std::vector<char32_t>{};
+        for (auto&& item : enumerate(as_code_points, str)) {
+            values.push_back(item.value.value);
+        }
+        REQUIRE(
+            values
+            == std::vector<char32_t>{
+                0xFFFD, U'x', 0xFFFD, 0xFFFD, 0xFFFD, 0xFFFD, 0xFFFD, 0xFFFD});
+    }
+    SECTION("utf-16")
+    {
+        auto const str     = u"a\U0001F600b";
+        auto       offsets = std::vector<std::size_t>{};
+        auto       values  = std::vector<char32_t>{};
+        for (auto&& item : enumerate_as<int>(as_code_points, str, str + 4)) {
             assert_same<int, decltype(item.index)>();
-            assert_same<int const&, decltype(item.value)>();
-
-            REQUIRE(&container[item.index] == &item.value);
-            REQUIRE(item.index * 10 == item.value);
+            offsets.push_back(item.value.offset);
+            values.push_back(item.value.value);
+        }
+        REQUIRE(offsets == std::vector<std::size_t>{0, 1, 3});
+        REQUIRE(values == std::vector<char32_t>{U'a', 0x1F600, U'b'});
 
-            ++counter;
+        char16_t const lone[] = {0xDC00, 0xD800, u'x'};
+        values.clear();
+        for (auto&& item : enumerate(as_code_points, &lone[0], &lone[3])) {
+            values.push_back(item.value.value);
         }
-        REQUIRE(counter == 3);
+        REQUIRE(values == std::vector<char32_t>{0xFFFD, 0xFFFD, U'x'});
+    }
+    SECTION("each")
+    {
+        auto const str
+            = std::string("The quick brown fox \xE2\x80\x94 jumps over the lazy dog, ")
+              + "\xC3\xA9t\xC3\xA9 \xF0\x9F\x98\x80 0123456789abcdefghijklmnopqrstuvwxyz";
+        auto const range = enumerate(as_code_points, str.data(), str.data() + str.size());
+
+        auto expected = std::vector<std::pair<std::size_t, code_point>>{};
+        for (auto&& item : range) {
+            expected.emplace_back(item.index, item.value);
+        }
+        auto actual = std::vector<std::pair<std::size_t, code_point>>{};
+        range.each([&](std::size_t index, code_point value) { actual.emplace_back(index, value); });
+        REQUIRE(actual == expected);
+
+        auto const wide = std::u16string(u"plain text that spans more than one block \u00E9\u4E2D ")
+                          + u"\U0001F600 and some more plain text after it";
+        auto const wide_range = enumerate(as_code_points, wide.data(), wide.data() + wide.size());
+
+        expected.clear();
+        for (auto&& item : wide_range) {
+            expected.emplace_back(item.index, item.value);
+        }
+        actual.clear();
+        wide_range.each(
+            [&](std::size_t index, code_point value) { actual.emplace_back(index, value); });
+        REQUIRE(actual == expected);
+    }
+    SECTION("empty")
+    {
+        char const* str = nullptr;
+        auto const  range = enumerate(as_code_points, str);
+        REQUIRE(range.begin() == range.end());
+        REQUIRE(enumerate(as_code_points, "").begin() == enumerate(as_code_points, "").end());
     }
-#endif
 }
 
-#if HIPONY_ENUMERATE_HAS_CONSTEXPR
-
-TEST_CASE("constexpr")
+#if HIPONY_ENUMERATE_HAS_STRING_VIEW
+TEST_CASE("enumerate_lines")
 {
-    struct function_object {
-        constexpr auto operator()() const -> int
-        {
-            for (auto item : enumerate(as_array, 0, 10, 20, 30, 40)) {
-                if (item.index == 3) {
-                    return item.value;
-                }
-            }
-            return 0;
+    SECTION("text")
+    {
+        auto const text  = std::string_view("first\nsecond\r\n\nlast");
+        auto       lines = std::vector<std::string_view>{};
+        for (auto&& [index, line] : enumerate_lines(text)) {
+            assert_same<std::size_t, decltype(index)>();
+            assert_same<std::string_view, decltype(line)>();
+
+            REQUIRE(index == lines.size());
+            lines.push_back(line);
         }
-    };
-    constexpr auto const value = function_object{}();
-    REQUIRE(value == 30);
+        REQUIRE(lines == std::vector<std::string_view>{"first", "second\r", "", "last"});
+        REQUIRE(lines[0].data() == text.data());
+    }
+    SECTION("trailing newline")
+    {
+        auto counter = 0;
+        for (auto&& item : enumerate_lines_as<int>("a\nb\n")) {
+            assert_same<int, decltype(item.index)>();
+            ++counter;
+        }
+        REQUIRE(counter == 2);
+        REQUIRE(std::distance(enumerate_lines("\n").begin(), enumerate_lines("\n").end()) == 1);
+    }
+    SECTION("empty")
+    {
+        auto const range = enumerate_lines("");
+        REQUIRE(range.begin() == range.end());
+    }
 }
 
-#endif
+TEST_CASE("line_index")
+{
+    auto const text  = std::string_view("zero\none\n\nthree\r\nfour");
+    auto const index = line_index(text);
+    REQUIRE(index.size() == 5);
+    REQUIRE(index.offset(3) == 10);
 
-#if HIPONY_ENUMERATE_HAS_AGGREGATES
+    SECTION("for-range")
+    {
+        auto const range = enumerate_lines(text, index);
+        static_assert(
+            std::is_base_of<
+                std::random_access_iterator_tag,
+                std::iterator_traits<decltype(range.begin())>::iterator_category>::value,
+            "Indexed lines should be random-access");
+
+        auto lines = std::vector<std::string_view>{};
+        for (auto&& [line, value] : range) {
+            REQUIRE(line == lines.size());
+            lines.push_back(value);
+        }
+        REQUIRE(lines == std::vector<std::string_view>{"zero", "one", "", "three\r", "four"});
+        REQUIRE(range.end() - range.begin() == 5);
+    }
+    SECTION("seek")
+    {
+        auto const range   = enumerate_lines(text, index);
+        auto       counter = 3;
+        for (auto&& [line, value] : seek(range, 3)) {
+            REQUIRE(line == static_cast<std::size_t>(counter));
+            ++counter;
+        }
+        REQUIRE(counter == 5);
+        REQUIRE((*seek(range, 4).begin()).value == "four");
+        REQUIRE(seek(range, 5).empty());
+    }
+    SECTION("split")
+    {
+        auto const parts = split(enumerate_lines(text, index), 2);
+        REQUIRE(parts.size() == 2);
+        REQUIRE((*parts[1].begin()).index == 3);
+        REQUIRE((*parts[1].begin()).value == "three\r");
+    }
+    SECTION("trailing newline")
+    {
+        auto const terminated = std::string_view("a\nb\n");
+        auto const other      = line_index(terminated);
+        REQUIRE(other.size() == 2);
+        REQUIRE((*(enumerate_lines(terminated, other).begin() + 1)).value == "b");
+        REQUIRE(line_index(std::string_view()).size() == 0);
+    }
+}
 
-TEST_CASE("aggregate_tag_t")
+TEST_CASE("csv")
 {
-    struct aggregate_t {
-        int         i;
-        double      d;
-        char const* str;
-    };
-    SECTION("prvalue")
+    SECTION("fields")
     {
-        auto counter = 0;
-        enumerate(aggregate_t{0, 1., "str"}).each([&](auto index, auto& value) {
-            REQUIRE(index == index_of<typename std::decay<decltype(value)>::type>());
+        auto const text = std::string_view("name,age\n\"Smith, J\",42\r\n\"a\"\"b\",\n");
+        auto const expected = std::vector<std::tuple<std::size_t, std::size_t, std::string, bool>>{
+            {0, 0, "name", false},
+            {0, 1, "age", false},
+            {1, 0, "Smith, J", true},
+            {1, 1, "42", false},
+            {2, 0, "a\"\"b", true},
+            {2, 1, "", false}};
+
+        auto counter = std::size_t{0};
+        for (auto&& [index, field] : enumerate(csv_dialect{}, text)) {
+            assert_same<std::size_t, decltype(index)>();
+            assert_same<csv_field, decltype(field)>();
+            REQUIRE(index == counter);
+            REQUIRE(field.row == std::get<0>(expected[index]));
+            REQUIRE(field.column == std::get<1>(expected[index]));
+            REQUIRE(field.text == std::get<2>(expected[index]));
+            REQUIRE(field.quoted == std::get<3>(expected[index]));
             ++counter;
-        });
-        REQUIRE(counter == 3);
+        }
+        REQUIRE(counter == expected.size());
     }
-    SECTION("lvalue")
+    SECTION("blocks")
     {
-        auto counter   = 0;
-        auto aggregate = aggregate_t{0, 1., "str"};
-        enumerate(aggregate).each([&](auto index, auto& value) {
-            assert_same<decltype(index), std::size_t>();
-
-            REQUIRE(index == index_of<typename std::decay<decltype(value)>::type>());
+        // NOTE: Quoted delimiters and newlines land on both sides of the 64-byte block boundaries
+        auto text = std::string{};
+        for (auto i = 0; i < 1000; ++i) {
+            text += std::to_string(i) + ",\"x,\n"
+                    + std::string(static_cast<std::size_t>(i % 70), 'y') + "\","
+                    + std::to_string(i * 2) + '\n';
+        }
+
+        auto counter    = std::size_t{0};
+        auto mismatches = 0;
+        for (auto&& [index, field] : enumerate(csv_dialect{}, text)) {
+            auto const row = static_cast<int>(field.row);
+            mismatches += field.row != index / 3 || field.column != index % 3 ? 1 : 0;
+            if (field.column == 0) {
+                mismatches += field.text != std::to_string(row) ? 1 : 0;
+            } else if (field.column == 1) {
+                auto const size = 3 + static_cast<std::size_t>(row % 70);
+                mismatches += !field.quoted || field.text.size() != size ? 1 : 0;
+            } else {
+                mismatches += field.text != std::to_string(row * 2) ? 1 : 0;
+            }
             ++counter;
-        });
-        REQUIRE(counter == 3);
+        }
+        REQUIRE(mismatches == 0);
+        REQUIRE(counter == 3000);
     }
-    SECTION("const")
+    SECTION("carriage return")
     {
-        auto       counter   = 0;
-        auto const aggregate = aggregate_t{0, 1., "str"};
-        enumerate(aggregate).each([&](auto index, auto& value) {
-            assert_same<decltype(index), std::size_t>();
-            static_assert(
-                std::is_const<typename std::remove_reference<decltype(value)>::type>::value,
+        // NOTE: Only a '\r' right before the newline belongs to the line ending
+        auto fields = std::vector<std::string_view>{};
+        for (auto&& item : enumerate(csv_dialect{}, std::string_view("a\r,b\r\nc\r"))) {
+            fields.push_back(item.value.text);
+        }
+        REQUIRE(fields == std::vector<std::string_view>{"a\r", "b", "c\r"});
+    }
+    SECTION("tsv")
+    {
+        auto columns = std::vector<std::size_t>{};
+        for (auto&& item : enumerate_as<int>(csv_dialect{'\t'}, "a\tb,c\td")) {
+            assert_same<int, decltype(item.index)>();
+            columns.push_back(item.value.column);
+        }
+        REQUIRE(columns == std::vector<std::size_t>{0, 1, 2});
+    }
+    SECTION("empty")
+    {
+        auto counter = 0;
+        for (auto&& item : enumerate(csv_dialect{}, std::string_view())) {
+            static_cast<void>(item);
+            ++counter;
+        }
+        REQUIRE(counter == 0);
+    }
+}
+#endif
+
+#if HIPONY_ENUMERATE_HAS_BYTE
+TEST_CASE("records")
+{
+    SECTION("fixed")
+    {
+        // NOTE: The last record is torn, its prefix says 9 bytes but only 2 are left
+        auto const buffer = std::string("\x03\x00\x00\x00" "abc"
+                                        "\x00\x00\x00\x00"
+                                        "\x05\x00\x00\x00" "hello"
+                                        "\x09\x00\x00\x00" "to",
+                                        28);
+        auto const expected = std::vector<std::pair<std::size_t, std::string>>{
+            {0, "abc"}, {7, ""}, {11, "hello"}};
+
+        auto const range   = enumerate(fixed_prefix<std::uint32_t>{}, buffer.data(), buffer.size());
+        auto       counter = std::size_t{0};
+        for (auto&& [index, value] : range) {
+            assert_same<std::size_t, decltype(index)>();
+            assert_same<length_record, decltype(value)>();
+            REQUIRE(value.offset == expected[index].first);
+            REQUIRE(
+                std::string(reinterpret_cast<char const*>(value.data.begin()), value.data.size())
+                == expected[index].second);
+            ++counter;
+        }
+        REQUIRE(counter == 3);
+        REQUIRE(range.data.consumed() == 20);
+        REQUIRE_FALSE(range.data.clean());
+    }
+    SECTION("big-endian")
+    {
+        auto const buffer = std::vector<unsigned char>{0x00, 0x02, 'h', 'i', 0x00, 0x01, '!'};
+        auto       sizes  = std::vector<std::size_t>{};
+        auto const range  = enumerate(
+            fixed_prefix<std::uint16_t, true>{}, buffer.data(), buffer.data() + buffer.size());
+        for (auto&& item : range) {
+            sizes.push_back(item.value.data.size());
+        }
+        REQUIRE(sizes == std::vector<std::size_t>{2, 1});
+        REQUIRE(range.data.clean());
+    }
+    SECTION("varint")
+    {
+        auto buffer = std::vector<std::byte>{std::byte{0xAC}, std::byte{0x02}};
+        buffer.resize(2 + 300, std::byte{0x11});
+        buffer.push_back(std::byte{0x01});
+        buffer.push_back(std::byte{0x22});
+
+        auto records = std::vector<std::pair<std::size_t, std::size_t>>{};
+        for (auto&& [index, value] :
+             enumerate_as<int>(varint_prefix{}, buffer.data(), buffer.size())) {
+            assert_same<int, decltype(index)>();
+            REQUIRE(value.data.begin() == buffer.data() + value.offset + (index == 0 ? 2 : 1));
+            records.emplace_back(value.offset, value.data.size());
+        }
+        REQUIRE(records == std::vector<std::pair<std::size_t, std::size_t>>{{0, 300}, {302, 1}});
+    }
+    SECTION("varint overflow")
+    {
+        auto buffer = std::vector<std::byte>(9, std::byte{0xFF});
+        buffer.push_back(std::byte{0x01});
+        auto length = std::uint64_t{};
+        REQUIRE(varint_prefix::decode(buffer.data(), buffer.data() + buffer.size(), length) == 10);
+        REQUIRE(length == (std::numeric_limits<std::uint64_t>::max)());
+
+        buffer.back() = std::byte{0x02};
+        REQUIRE(varint_prefix::decode(buffer.data(), buffer.data() + buffer.size(), length) == 0);
+        auto const range = enumerate(varint_prefix{}, buffer.data(), buffer.size());
+        REQUIRE(range.begin() == range.end());
+        REQUIRE(range.data.consumed() == 0);
+    }
+    SECTION("empty")
+    {
+        auto const buffer  = std::string{};
+        auto       counter = 0;
+        for (auto&& item : enumerate(varint_prefix{}, buffer.data(), buffer.size())) {
+            static_cast<void>(item);
+            ++counter;
+        }
+        REQUIRE(counter == 0);
+    }
+}
+#endif
+
+#if HIPONY_ENUMERATE_HAS_FILES
+TEST_CASE("mapped_file")
+{
+    auto const path = std::string("enumerate-mapped-file.test.txt");
+    {
+        auto file = std::ofstream(path, std::ios::binary);
+        for (auto i = 0; i < 1000; ++i) {
+            file << "line " << i << '\n';
+        }
+    }
+
+    SECTION("lines")
+    {
+        auto counter = 0;
+        for (auto&& [index, line] : enumerate_lines(mapped_file(path))) {
+            REQUIRE(line == "line " + std::to_string(index));
+            ++counter;
+        }
+        REQUIRE(counter == 1000);
+    }
+    SECTION("move")
+    {
+        auto file  = mapped_file(path);
+        auto other = std::move(file);
+        REQUIRE(file.data() == nullptr);
+        REQUIRE(other.size() == std::size_t{8890});
+        file = std::move(other);
+        REQUIRE(std::string_view(file.data(), 5) == "line ");
+    }
+    SECTION("missing")
+    {
+        REQUIRE_THROWS_AS(mapped_file("enumerate-missing.test.txt"), std::system_error);
+    }
+    SECTION("line_index")
+    {
+        auto const sidecar = path + ".idx";
+        line_index(mapped_file(path)).save(sidecar);
+
+        auto const index = line_index::load(sidecar, 8890);
+        REQUIRE(index.size() == 1000);
+
+        auto const range = enumerate_lines(mapped_file(path), index);
+        auto       line  = 500;
+        for (auto&& item : seek(range, 500)) {
+            REQUIRE(item.index == static_cast<std::size_t>(line));
+            REQUIRE(item.value == "line " + std::to_string(line));
+            ++line;
+        }
+        REQUIRE(line == 1000);
+
+        auto const bytes = mapped_file(sidecar);
+        REQUIRE(bytes.size() == 8 * (3 + 1001));
+        REQUIRE(std::string_view(bytes.data(), 8) == "HYNLNDX1");
+        REQUIRE(bytes.data()[8] == static_cast<char>(8890 & 0xFF));
+
+        REQUIRE_THROWS_AS(line_index::load(sidecar, 8891), std::system_error);
+        {
+            auto file = std::fstream(sidecar, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(8 * (3 + 500));
+            file.write("\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x7F", 8);
+        }
+        REQUIRE_THROWS_AS(line_index::load(sidecar, 8890), std::system_error);
+        std::remove(sidecar.c_str());
+
+        try {
+            index.save("enumerate-missing/test.idx");
+            FAIL("Saving into a missing directory should throw");
+        } catch (std::system_error const& error) {
+            REQUIRE(error.code() == std::errc::no_such_file_or_directory);
+        }
+    }
+
+    std::remove(path.c_str());
+}
+
+namespace {
+
+struct record {
+    std::uint64_t time;
+    double        price;
+    std::uint32_t quantity;
+    std::uint32_t flags;
+};
+
+} // namespace
+
+TEST_CASE("mapped_array")
+{
+    auto const path = std::string("enumerate-mapped-array.test.bin");
+    {
+        auto file = std::ofstream(path, std::ios::binary);
+        for (auto i = std::uint32_t{0}; i < 10000; ++i) {
+            auto const value = record{i * 10u, i * 0.5, i, 0};
+            file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+        }
+    }
+
+    SECTION("lvalue")
+    {
+        auto const records = mapped_array<record>(path, map_policy{MADV_SEQUENTIAL, true});
+        REQUIRE(records.size() == 10000);
+        REQUIRE(records[42].quantity == 42);
+
+        auto counter    = std::size_t{0};
+        auto mismatches = 0;
+        for (auto&& [index, value] : enumerate(records)) {
+            assert_same<record const&, decltype(value)>();
+            mismatches += &value != records.data() + index ? 1 : 0;
+            mismatches += value.time != index * 10 ? 1 : 0;
+            ++counter;
+        }
+        REQUIRE(mismatches == 0);
+        REQUIRE(counter == 10000);
+    }
+    SECTION("rvalue")
+    {
+        auto counter = std::size_t{0};
+        for (auto&& item : enumerate(mapped_array<record>(path), 100u)) {
+            REQUIRE(item.index == item.value.quantity);
+            ++counter;
+        }
+        REQUIRE(counter == 100);
+    }
+    SECTION("misaligned size")
+    {
+        using bytes = std::array<char, 7>;
+        REQUIRE_THROWS_AS(mapped_array<bytes>(path), std::system_error);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("prefetch")
+{
+    auto const path = std::string("enumerate-prefetch.test.bin");
+    {
+        auto file = std::ofstream(path, std::ios::binary);
+        for (auto i = std::uint64_t{0}; i < 512 * 1024; ++i) {
+            file.write(reinterpret_cast<char const*>(&i), sizeof(i));
+        }
+    }
+    auto const values = mapped_array<std::uint64_t>(path);
+    auto const pages  = values.size() * sizeof(std::uint64_t)
+                       / static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+    SECTION("for-range")
+    {
+        auto stats      = prefetch_stats{};
+        auto counter    = std::size_t{0};
+        auto mismatches = 0;
+        for (auto&& [index, value] :
+             enumerate(prefetch_policy{64 * 1024, true, &stats}, values)) {
+            assert_same<std::uint64_t const&, decltype(value)>();
+            mismatches += value != index ? 1 : 0;
+            ++counter;
+        }
+        REQUIRE(mismatches == 0);
+        REQUIRE(counter == values.size());
+        REQUIRE(stats.hits + stats.misses == pages);
+    }
+    SECTION("each")
+    {
+        auto stats      = prefetch_stats{};
+        auto counter    = std::size_t{0};
+        auto mismatches = 0;
+        enumerate(prefetch_policy{64 * 1024, false, &stats}, values.begin() + 1, values.end())
+            .each([&](std::size_t index, std::uint64_t value) {
+                mismatches += value != index + 1 ? 1 : 0;
+                ++counter;
+            });
+        REQUIRE(mismatches == 0);
+        REQUIRE(counter == values.size() - 1);
+        REQUIRE(stats.hits + stats.misses == pages);
+    }
+    SECTION("caller-owned")
+    {
+        // NOTE: Anonymous memory would be zeroed by MADV_DONTNEED, release must not apply here
+        auto owned = std::vector<std::uint64_t>(512 * 1024);
+        for (std::size_t i = 0; i < owned.size(); ++i) {
+            owned[i] = i;
+        }
+        auto counter = std::size_t{0};
+        for (auto&& item : enumerate(
+                 prefetch_policy{64 * 1024, true}, owned.data() + 1, owned.data() + owned.size())) {
+            counter += item.value == item.index + 1 ? 1 : 0;
+        }
+        REQUIRE(counter == owned.size() - 1);
+
+        auto mismatches = 0;
+        for (std::size_t i = 0; i < owned.size(); ++i) {
+            mismatches += owned[i] != i ? 1 : 0;
+        }
+        REQUIRE(mismatches == 0);
+    }
+    SECTION("default")
+    {
+        REQUIRE_FALSE(prefetch_policy{}.release);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("shared_array")
+{
+    auto const name = "/hipony-enumerate-test-" + std::to_string(::getpid());
+
+    auto producer = shared_array<std::uint32_t>::create(name, 100000);
+    REQUIRE(producer.size() == 100000);
+    for (auto&& [index, value] : enumerate(producer)) {
+        assert_same<std::uint32_t&, decltype(value)>();
+        value = static_cast<std::uint32_t>(index * 3);
+    }
+    REQUIRE_THROWS_AS(shared_array<std::uint32_t>::create(name, 1), std::system_error);
+
+    SECTION("two processes")
+    {
+        auto const child = ::fork();
+        REQUIRE(child != -1);
+        if (child == 0) {
+            auto mismatches = std::size_t{0};
+            try {
+                auto const consumer = shared_array<std::uint32_t const>(name);
+                for (auto&& [index, value] : enumerate(consumer)) {
+                    mismatches += value != index * 3 ? 1 : 0;
+                }
+                mismatches += consumer.size() != 100000 ? 1 : 0;
+            } catch (...) {
+                ::_exit(2);
+            }
+            ::_exit(mismatches == 0 ? 0 : 1);
+        }
+        auto status = 0;
+        REQUIRE(::waitpid(child, &status, 0) == child);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+    }
+    SECTION("read-only")
+    {
+        auto consumer = shared_array<std::uint32_t const>(name);
+        for (auto&& item : enumerate(consumer)) {
+            assert_same<std::uint32_t const&, decltype(item.value)>();
+            break;
+        }
+        producer[7] = 1;
+        REQUIRE(consumer[7] == 1);
+    }
+    SECTION("overflow")
+    {
+        auto const other = name + "-overflow";
+        auto const size  = (std::numeric_limits<std::size_t>::max)() / 2;
+        REQUIRE_THROWS_AS(shared_array<std::uint32_t>::create(other, size), std::system_error);
+        REQUIRE_THROWS_AS(shared_array<std::uint32_t const>(other), std::system_error);
+    }
+
+    REQUIRE(shared_array<std::uint32_t>::remove(name));
+    REQUIRE_THROWS_AS(shared_array<std::uint32_t const>(name), std::system_error);
+}
+
+TEST_CASE("file_blocks")
+{
+    auto const path = std::string("enumerate-file-blocks.test.bin");
+    {
+        auto file = std::ofstream(path, std::ios::binary);
+        for (auto i = 0; i < 100000; ++i) {
+            file.put(static_cast<char>(i % 251));
+        }
+    }
+
+    for (auto io_uring : {true, false}) {
+        auto const blocks = file_blocks(path, block_policy{4096, 3, io_uring});
+        REQUIRE(blocks.size() == 25);
+        if (!io_uring) {
+            REQUIRE_FALSE(blocks.uses_io_uring());
+        }
+
+        auto counter    = std::size_t{0};
+        auto total      = std::size_t{0};
+        auto mismatches = 0;
+        for (auto&& [index, span] : enumerate(blocks)) {
+            assert_same<byte_span const&, decltype(span)>();
+            mismatches += index != counter ? 1 : 0;
+            auto offset = index * 4096;
+            for (auto byte : span) {
+                mismatches += static_cast<std::size_t>(byte) != offset++ % 251 ? 1 : 0;
+            }
+            total += span.size();
+            ++counter;
+        }
+        REQUIRE(mismatches == 0);
+        REQUIRE(counter == 25);
+        REQUIRE(total == 100000);
+
+        auto limited = std::size_t{0};
+        for (auto&& item : enumerate(file_blocks(path, block_policy{4096, 8, io_uring}), 5u)) {
+            REQUIRE(item.index == limited);
+            REQUIRE(item.value.size() == 4096);
+            ++limited;
+        }
+        REQUIRE(limited == 5);
+
+        // NOTE: Destroying a reader mid-pass waits for the reads still in flight
+        {
+            auto const abandoned = file_blocks(path, block_policy{4096, 8, io_uring});
+            auto const first     = abandoned.begin();
+            REQUIRE((*first).size() == 4096);
+        }
+
+        // NOTE: A second begin() drains the reads of the abandoned pass before restarting
+        auto const restarted = file_blocks(path, block_policy{4096, 4, io_uring});
+        auto       it        = restarted.begin();
+        ++it;
+        ++it;
+        auto offset = std::size_t{0};
+        for (auto const& span : restarted) {
+            for (auto byte : span) {
+                mismatches += static_cast<std::size_t>(byte) != offset++ % 251 ? 1 : 0;
+            }
+        }
+        REQUIRE(mismatches == 0);
+        REQUIRE(offset == 100000);
+    }
+    SECTION("empty")
+    {
+        auto const empty = path + ".empty";
+        std::ofstream(empty, std::ios::binary).close();
+        auto counter = 0;
+        for (auto&& item : enumerate(file_blocks(empty))) {
+            static_cast<void>(item);
+            ++counter;
+        }
+        REQUIRE(counter == 0);
+        std::remove(empty.c_str());
+    }
+    SECTION("missing")
+    {
+        REQUIRE_THROWS_AS(file_blocks("enumerate-missing.test.bin"), std::system_error);
+    }
+
+    std::remove(path.c_str());
+}
+#endif
+
+TEST_CASE("istream")
+{
+    SECTION("for-range")
+    {
+        // NOTE: Larger than a single block
+        auto str = std::string(100000, 'x');
+        str[70000] = 'y';
+        auto stream = std::istringstream(str);
+
+        auto counter    = std::size_t{0};
+        auto found      = std::size_t{0};
+        auto mismatches = 0;
+        for (auto&& item : enumerate(stream)) {
+            assert_same<std::size_t, decltype(item.index)>();
+            assert_same<char, decltype(item.value)>();
+
+            mismatches += item.index != counter ? 1 : 0;
+            if (item.value == 'y') {
+                found = item.index;
+            }
+            ++counter;
+        }
+        REQUIRE(mismatches == 0);
+        REQUIRE(counter == str.size());
+        REQUIRE(found == 70000);
+        REQUIRE(stream.eof());
+    }
+    SECTION("each")
+    {
+        auto const str    = std::string(100000, 'x') + "yz";
+        auto       stream = std::istringstream(str);
+        auto       result = std::string();
+        auto       last   = -1;
+        auto       gaps   = 0;
+        enumerate_as<int>(stream).each([&](int index, char value) {
+            gaps += index != last + 1 ? 1 : 0;
+            last = index;
+            result.push_back(value);
+        });
+        REQUIRE(gaps == 0);
+        REQUIRE(result == str);
+    }
+    SECTION("wide")
+    {
+        auto stream = std::wistringstream(L"012");
+        auto counter = 0;
+        for (auto&& item : enumerate(stream)) {
+            REQUIRE(static_cast<wchar_t>(L'0' + item.index) == item.value);
+            ++counter;
+        }
+        REQUIRE(counter == 3);
+    }
+    SECTION("empty")
+    {
+        auto       stream = std::istringstream();
+        auto const range  = enumerate(stream);
+        REQUIRE(range.begin() == range.end());
+    }
+}
+
+TEST_CASE("array_tag_t")
+{
+    // FIXME: The lifetime of the array prvalue will end after the function call returns
+    // SECTION("prvalue")
+    // {
+    //     auto counter = 0;
+    //     for (auto&& item : enumerate({0, 10, 20, 30, 40})) {
+    //         assert_same<std::size_t, decltype(item.index)>();
+    //         assert_same<int&, decltype(item.value)>();
+
+    //         REQUIRE(item.index * 10 == item.value);
+
+    //         ++counter;
+    //     }
+    //     REQUIRE(counter == 5);
+    // }
+    SECTION("for-range")
+    {
+        auto counter     = 0;
+        int  container[] = {0, 10, 20, 30, 40};
+        for (auto&& item : enumerate(container)) {
+            assert_same<std::size_t, decltype(item.index)>();
+            assert_same<int&, decltype(item.value)>();
+
+            REQUIRE(&container[item.index] == &item.value);
+            REQUIRE(item.index * 10 == item.value);
+
+            ++counter;
+        }
+        REQUIRE(counter == 5);
+    }
+    SECTION("const")
+    {
+        auto      counter     = 0;
+        int const container[] = {0, 10, 20, 30, 40};
+        for (auto&& item : enumerate(container)) {
+            assert_same<std::size_t, decltype(item.index)>();
+            assert_same<int const&, decltype(item.value)>();
+
+            REQUIRE(&container[item.index] == &item.value);
+            REQUIRE(item.index * 10 == item.value);
+
+            ++counter;
+        }
+        REQUIRE(counter == 5);
+    }
+    SECTION("as int")
+    {
+        auto      counter     = 0;
+        int const container[] = {0, 10, 20, 30, 40};
+        for (auto&& item : enumerate_as<int>(container)) {
+            assert_same<int, decltype(item.index)>();
+            assert_same<int const&, decltype(item.value)>();
+
+            REQUIRE(&container[item.index] == &item.value);
+            REQUIRE(item.index * 10 == item.value);
+
+            ++counter;
+        }
+        REQUIRE(counter == 5);
+    }
+#if HIPONY_ENUMERATE_HAS_RANGES && !defined(__clang__)
+    SECTION("ranges")
+    {
+        auto       counter     = 0;
+        int const  container[] = {0, 10, 20, 30, 40};
+        auto const range       = enumerate_as<int>(container);
+        for (auto&& item : range | std::ranges::views::take(3)) {
+            assert_same<int, decltype(item.index)>();
+            assert_same<int const&, decltype(item.value)>();
+
+            REQUIRE(&container[item.index] == &item.value);
+            REQUIRE(item.index * 10 == item.value);
+
+            ++counter;
+        }
+        REQUIRE(counter == 3);
+    }
+    SECTION("ranges-pipe")
+    {
+        auto      counter     = 0;
+        int const container[] = {0, 10, 20, 30, 40};
+        for (auto&& item : container | std::ranges::views::take(3) | enumerate_as<int>()) {
+            assert_same<int, decltype(item.index)>();
+            assert_same<int const&, decltype(item.value)>();
+
+            REQUIRE(&container[item.index] == &item.value);
+            REQUIRE(item.index * 10 == item.value);
+
+            ++counter;
+        }
+        REQUIRE(counter == 3);
+    }
+#endif
+}
+
+TEST_CASE("random_access")
+{
+    SECTION("container")
+    {
+        auto       vector = std::vector<int>({0, 10, 20, 30, 40});
+        auto const range  = enumerate(vector);
+        using iterator    = decltype(range.begin());
+        assert_same<
+            std::random_access_iterator_tag,
+            std::iterator_traits<iterator>::iterator_category>();
+
+        REQUIRE(range.end() - range.begin() == 5);
+        REQUIRE(range.begin()[3].index == 3);
+        REQUIRE(range.begin()[3].value == 30);
+        REQUIRE(range.begin() < range.end());
+
+        auto it = range.begin();
+        std::advance(it, 4);
+        REQUIRE((*it).index == 4);
+        it -= 2;
+        REQUIRE((*it).index == 2);
+        REQUIRE(&(*it).value == &vector[2]);
+
+        auto last = range.end();
+        --last;
+        REQUIRE((*last).index == 4);
+        REQUIRE((*last).value == 40);
+    }
+    SECTION("binary search")
+    {
+        auto const vector = std::vector<int>({0, 10, 20, 30, 40});
+        auto const range  = enumerate(vector);
+        auto const it     = std::lower_bound(
+            range.begin(), range.end(), 25, [](decltype(*range.begin()) item, int value) {
+                return item.value < value;
+            });
+        REQUIRE((*it).index == 3);
+        REQUIRE((*it).value == 30);
+    }
+    SECTION("c-array")
+    {
+        int const  container[] = {0, 10, 20, 30, 40};
+        auto const range       = enumerate(container);
+        REQUIRE(range.end() - range.begin() == 5);
+        REQUIRE((*(range.begin() + 2)).index == 2);
+        REQUIRE((*(range.end() - 1)).value == 40);
+    }
+    SECTION("limited")
+    {
+        auto const vector = std::vector<int>({0, 10, 20, 30, 40});
+        auto const range  = enumerate(vector, 3u);
+        REQUIRE(range.end() - range.begin() == 3);
+        REQUIRE((*(range.end() - 1)).index == 2);
+        REQUIRE((*(range.end() - 1)).value == 20);
+
+        auto const clamped = enumerate(vector, 10u);
+        REQUIRE(clamped.end() - clamped.begin() == 5);
+        REQUIRE((*(clamped.end() - 1)).index == 4);
+    }
+    SECTION("bidirectional")
+    {
+        auto const list  = std::list<int>({0, 10, 20, 30, 40});
+        auto const range = enumerate(list.begin(), list.end());
+        auto       it    = range.begin();
+        ++it;
+        ++it;
+        REQUIRE((*it--).value == 20);
+        REQUIRE((*it).value == 10);
+    }
+}
+
+#if HIPONY_ENUMERATE_CPP14_OR_GREATER
+
+TEST_CASE("each")
+{
+    SECTION("container")
+    {
+        auto vector = std::vector<int>(100);
+        enumerate(vector).each([](auto index, auto& value) {
+            assert_same<decltype(index), std::size_t>();
+            value = static_cast<int>(index) * 2;
+        });
+        for (auto&& item : enumerate(vector)) {
+            REQUIRE(static_cast<int>(item.index) * 2 == item.value);
+        }
+    }
+    SECTION("const")
+    {
+        auto const vector = std::vector<int>({0, 10, 20, 30, 40});
+        auto const range  = enumerate_as<int>(vector);
+        auto       sum    = 0;
+        range.each([&](auto index, auto& value) {
+            assert_same<decltype(index), int>();
+            static_assert(
+                std::is_const<typename std::remove_reference<decltype(value)>::type>::value,
+                "Const propagation is broken");
+            REQUIRE(index * 10 == value);
+            sum += value;
+        });
+        REQUIRE(sum == 100);
+    }
+    SECTION("list")
+    {
+        auto const list    = std::list<int>({0, 10, 20, 30, 40});
+        auto       counter = 0;
+        enumerate(list).each([&](auto index, auto& value) {
+            REQUIRE(static_cast<int>(index) * 10 == value);
+            ++counter;
+        });
+        REQUIRE(counter == 5);
+    }
+    SECTION("limited")
+    {
+        auto const list    = std::list<int>({0, 10, 20, 30, 40});
+        auto const vector  = std::vector<int>({0, 10, 20, 30, 40});
+        auto       counter = 0;
+        enumerate(list, 3u).each([&](auto index, auto& value) {
+            REQUIRE(static_cast<int>(index) * 10 == value);
+            ++counter;
+        });
+        enumerate(vector, 10u).each([&](auto index, auto& value) {
+            REQUIRE(static_cast<int>(index) * 10 == value);
+            ++counter;
+        });
+        REQUIRE(counter == 8);
+    }
+    SECTION("c-array")
+    {
+        int container[] = {0, 10, 20, 30, 40};
+        auto counter     = 0;
+        enumerate(container).each([&](auto index, auto& value) {
+            REQUIRE(static_cast<int>(index) * 10 == value);
+            ++counter;
+        });
+        REQUIRE(counter == 5);
+    }
+    SECTION("string")
+    {
+        auto counter = 0;
+        enumerate("abc").each([&](auto index, auto value) {
+            REQUIRE(static_cast<char>('a' + index) == value);
+            ++counter;
+        });
+        REQUIRE(counter == 3);
+    }
+}
+
+namespace {
+
+template<typename T, typename = void>
+struct has_unrolled_each : std::false_type {};
+
+template<typename T>
+struct has_unrolled_each<
+    T,
+    decltype(std::declval<T&>().unrolled_each(std::declval<void (*)(std::size_t, int&)>()))>
+    : std::true_type {};
+
+} // namespace
+
+TEST_CASE("unrolled_each")
+{
+    SECTION("c-array")
+    {
+        int  container[] = {0, 10, 20, 30};
+        auto counter     = 0;
+        enumerate(container).unrolled_each([&](auto index, auto& value) {
+            assert_same<
+                decltype(index),
+                std::integral_constant<std::size_t, decltype(index)::value>>();
+            static_assert(decltype(index)::value < 4, "Index is out of bounds");
+
+            REQUIRE(static_cast<int>(index) * 10 == value);
+            ++counter;
+        });
+        REQUIRE(counter == 4);
+    }
+    SECTION("std::array")
+    {
+        auto const array   = std::array<int, 3>{{0, 10, 20}};
+        auto const tuple   = std::make_tuple(0, 10, 20);
+        auto       counter = 0;
+        enumerate_as<int>(array).unrolled_each([&](auto index, auto& value) {
+            assert_same<decltype(index), std::integral_constant<int, decltype(index)::value>>();
+
+            REQUIRE(std::get<decltype(index)::value>(tuple) == value);
+            ++counter;
+        });
+        REQUIRE(counter == 3);
+    }
+    SECTION("as_array")
+    {
+        auto counter = 0;
+        enumerate(as_array, 0, 10, 20, 30, 40).unrolled_each([&](auto index, auto& value) {
+            REQUIRE(static_cast<int>(index) * 10 == value);
+            ++counter;
+        });
+        REQUIRE(counter == 5);
+    }
+    SECTION("dynamic extent")
+    {
+        static_assert(
+            has_unrolled_each<decltype(enumerate(std::declval<int (&)[4]>()))>::value,
+            "C-arrays have a static extent");
+        static_assert(
+            !has_unrolled_each<decltype(enumerate(std::declval<std::vector<int>&>()))>::value,
+            "Vectors have a dynamic extent");
+        static_assert(
+            !has_unrolled_each<decltype(enumerate(std::declval<int*>(), 4u))>::value,
+            "Pointers have a dynamic extent");
+    }
+}
+
+#endif // HIPONY_ENUMERATE_CPP14_OR_GREATER
+
+TEST_CASE("split")
+{
+    SECTION("vector")
+    {
+        auto const vector = std::vector<int>({0, 10, 20, 30, 40, 50, 60});
+        auto const range  = enumerate(vector);
+        auto const parts  = split(range, 3);
+        REQUIRE(parts.size() == 3);
+        REQUIRE(parts[0].size() == 3);
+        REQUIRE(parts[1].size() == 2);
+        REQUIRE(parts[2].size() == 2);
+
+        auto counter = 0;
+        for (auto&& part : parts) {
+            for (auto&& item : part) {
+                assert_same<std::size_t, decltype(item.index)>();
+                assert_same<int const&, decltype(item.value)>();
+
+                REQUIRE(&vector[item.index] == &item.value);
+                REQUIRE(static_cast<int>(item.index) == counter);
+                ++counter;
+            }
+        }
+        REQUIRE(counter == 7);
+    }
+    SECTION("more parts than elements")
+    {
+        int const  container[] = {0, 10};
+        auto const parts       = split(enumerate(container), 4);
+        REQUIRE(parts.size() == 4);
+        REQUIRE(parts[0].size() == 1);
+        REQUIRE(parts[1].size() == 1);
+        REQUIRE(parts[2].empty());
+        REQUIRE(parts[3].empty());
+        REQUIRE((*parts[1].begin()).index == 1);
+    }
+    SECTION("chunks")
+    {
+        auto       vector = std::vector<int>({0, 10, 20, 30, 40, 50, 60});
+        auto const parts  = chunks(enumerate(vector), 3);
+        REQUIRE(parts.size() == 3);
+        REQUIRE(parts[2].size() == 1);
+        REQUIRE((*parts[2].begin()).index == 6);
+        for (auto&& item : parts[1]) {
+            item.value = -1;
+        }
+        REQUIRE(vector == std::vector<int>({0, 10, 20, -1, -1, -1, 60}));
+    }
+    SECTION("list")
+    {
+        auto const list    = std::list<int>({0, 10, 20, 30, 40});
+        auto const parts   = split(enumerate(list), 2);
+        auto       counter = 0;
+        for (auto&& part : parts) {
+            for (auto&& item : part) {
+                REQUIRE(static_cast<int>(item.index) * 10 == item.value);
+                ++counter;
+            }
+        }
+        REQUIRE(counter == 5);
+        REQUIRE((*parts[1].begin()).index == 3);
+    }
+    SECTION("limited")
+    {
+        auto const list  = std::list<int>({0, 10, 20, 30, 40});
+        auto const parts = chunks(enumerate(list, 4u), 2);
+        REQUIRE(parts.size() == 2);
+        REQUIRE((*parts[1].begin()).index == 2);
+        REQUIRE(parts[1].size() == 2);
+    }
+    SECTION("pointer")
+    {
+        int const  ptr[] = {0, 10, 20, 30, 40};
+        auto const parts = split(enumerate_as<int>(&ptr[0], 4), 2);
+        assert_same<int, decltype((*parts[1].begin()).index)>();
+        REQUIRE((*parts[1].begin()).index == 2);
+        REQUIRE(&(*parts[1].begin()).value == &ptr[2]);
+    }
+}
+
+namespace {
+
+struct split_tag {};
+
+struct proportional_split_tag {
+    HIPONY_ENUMERATE_NODISCARD auto left() const noexcept -> std::size_t
+    {
+        return 1;
+    }
+    HIPONY_ENUMERATE_NODISCARD auto right() const noexcept -> std::size_t
+    {
+        return 3;
+    }
+};
+
+} // namespace
+
+TEST_CASE("blocked")
+{
+    SECTION("split")
+    {
+        auto vector = std::vector<int>({0, 10, 20, 30, 40, 50, 60});
+        auto lhs    = blocked(enumerate(vector), 2);
+        REQUIRE(lhs.is_divisible());
+        auto rhs = decltype(lhs){lhs, split_tag{}};
+        REQUIRE(lhs.size() == 3);
+        REQUIRE(rhs.size() == 4);
+        REQUIRE((*rhs.begin()).index == 3);
+        REQUIRE((*rhs.begin()).value == 30);
+        REQUIRE(lhs.end() == rhs.begin());
+        REQUIRE(lhs.is_divisible());
+        auto tail = decltype(rhs){rhs, split_tag{}};
+        REQUIRE(!rhs.is_divisible());
+        REQUIRE((*tail.begin()).index == 5);
+    }
+    SECTION("proportional")
+    {
+        auto vector = std::vector<int>(8);
+        auto lhs    = blocked(enumerate(vector));
+        auto rhs    = decltype(lhs){lhs, proportional_split_tag{}};
+        REQUIRE(lhs.size() == 2);
+        REQUIRE(rhs.size() == 6);
+    }
+    SECTION("list")
+    {
+        auto list = std::list<int>({0, 10, 20, 30, 40});
+        auto lhs  = blocked(enumerate(list));
+        auto rhs  = decltype(lhs){lhs, split_tag{}};
+        REQUIRE((*rhs.begin()).index == 2);
+        REQUIRE((*rhs.begin()).value == 20);
+        REQUIRE(!decltype(lhs){lhs, split_tag{}}.is_divisible());
+        REQUIRE(lhs.size() == 1);
+    }
+    SECTION("empty")
+    {
+        auto vector = std::vector<int>();
+        auto range  = blocked(enumerate(vector));
+        REQUIRE(range.empty());
+        REQUIRE(!range.is_divisible());
+    }
+#if defined(HIPONY_ENUMERATE_TEST_TBB)
+    SECTION("tbb")
+    {
+        using blocked_type = decltype(blocked(enumerate(std::declval<std::vector<int>&>())));
+
+        auto vector = std::vector<int>(10000, -1);
+        tbb::parallel_for(blocked(enumerate(vector), 64), [](blocked_type const& range) {
+            for (auto&& item : range) {
+                item.value = static_cast<int>(item.index);
+            }
+        });
+        auto const sum = tbb::parallel_reduce(
+            blocked(enumerate(vector), 64),
+            std::size_t{0},
+            [](blocked_type const& range, std::size_t value) {
+                for (auto&& item : range) {
+                    value += item.index == static_cast<std::size_t>(item.value) ? 1 : 0;
+                }
+                return value;
+            },
+            [](std::size_t lhs, std::size_t rhs) { return lhs + rhs; });
+        REQUIRE(sum == vector.size());
+    }
+#endif
+}
+
+#if HIPONY_ENUMERATE_HAS_EXECUTION
+
+TEST_CASE("for_each")
+{
+    SECTION("random access")
+    {
+        auto vector = std::vector<int>(10000);
+        hipony::for_each(std::execution::par_unseq, enumerate(vector), [](auto&& item) {
+            item.value = static_cast<int>(item.index);
+        });
+        for (auto&& item : enumerate(vector)) {
+            REQUIRE(static_cast<int>(item.index) == item.value);
+        }
+    }
+    SECTION("limited")
+    {
+        auto vector = std::vector<int>(100, -1);
+        hipony::for_each(std::execution::par, enumerate(vector, 50u), [](auto&& item) {
+            item.value = static_cast<int>(item.index);
+        });
+        REQUIRE(vector[49] == 49);
+        REQUIRE(vector[50] == -1);
+    }
+    SECTION("c-array")
+    {
+        int container[64] = {};
+        hipony::for_each(std::execution::par, enumerate(container), [](auto&& item) {
+            item.value = static_cast<int>(item.index);
+        });
+        REQUIRE(container[63] == 63);
+    }
+    SECTION("serial fallback")
+    {
+        auto list    = std::list<int>(100);
+        auto counter = 0;
+        hipony::for_each(std::execution::par, enumerate(list), [&](auto&& item) {
+            REQUIRE(static_cast<int>(item.index) == counter);
+            ++counter;
+        });
+        REQUIRE(counter == 100);
+    }
+}
+
+#endif
+
+#if HIPONY_ENUMERATE_HAS_PARALLEL
+
+namespace {
+
+struct assign_index {
+    template<typename Item>
+    void operator()(Item&& item) const
+    {
+        item.value = static_cast<int>(item.index);
+    }
+};
+
+struct throw_at_500 {
+    template<typename Item>
+    void operator()(Item&& item) const
+    {
+        if (item.index == 500) {
+            throw std::runtime_error{"error"};
+        }
+    }
+};
+
+// NOTE: Input-only source that throws when dereferenced at `fail`
+struct counting_iterator {
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = int;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = int const*;
+    using reference         = int;
+
+    int value;
+    int fail;
+
+    counting_iterator(int value_ = 0, int fail_ = -1)
+        : value{value_}
+        , fail{fail_}
+    {}
+
+    auto operator*() const -> int
+    {
+        if (value == fail) {
+            throw std::runtime_error{"error"};
+        }
+        return value;
+    }
+
+    auto operator++() -> counting_iterator&
+    {
+        ++value;
+        return *this;
+    }
+
+    auto operator++(int) -> counting_iterator
+    {
+        auto tmp = *this;
+        ++value;
+        return tmp;
+    }
+
+    friend auto operator==(counting_iterator const& lhs, counting_iterator const& rhs) -> bool
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend auto operator!=(counting_iterator const& lhs, counting_iterator const& rhs) -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
+
+} // namespace
+
+TEST_CASE("work_stealing")
+{
+    SECTION("random access")
+    {
+        auto vector = std::vector<int>(10000, -1);
+        hipony::for_each(work_stealing_policy{4, 16}, enumerate(vector), assign_index{});
+        for (auto&& item : enumerate(vector)) {
+            REQUIRE(static_cast<int>(item.index) == item.value);
+        }
+    }
+    SECTION("forward")
+    {
+        auto list = std::list<int>(1000, -1);
+        hipony::for_each(work_stealing_policy{4, 7}, enumerate(list), assign_index{});
+        for (auto&& item : enumerate(list)) {
+            REQUIRE(static_cast<int>(item.index) == item.value);
+        }
+    }
+    SECTION("limited")
+    {
+        auto vector = std::vector<int>(100, -1);
+        hipony::for_each(work_stealing, enumerate(vector, 50u), assign_index{});
+        REQUIRE(vector[49] == 49);
+        REQUIRE(vector[50] == -1);
+    }
+    SECTION("empty")
+    {
+        auto vector = std::vector<int>();
+        hipony::for_each(work_stealing, enumerate(vector), assign_index{});
+        REQUIRE(vector.empty());
+    }
+    SECTION("exception")
+    {
+        auto vector = std::vector<int>(1000);
+        REQUIRE_THROWS_AS(
+            hipony::for_each(work_stealing_policy{4, 8}, enumerate(vector), throw_at_500{}),
+            std::runtime_error);
+    }
+}
+
+TEST_CASE("self_scheduling")
+{
+    SECTION("fixed block")
+    {
+        auto vector = std::vector<int>(10001, -1);
+        hipony::for_each(self_scheduling_policy{4, 64}, enumerate(vector), assign_index{});
+        for (auto&& item : enumerate(vector)) {
+            REQUIRE(static_cast<int>(item.index) == item.value);
+        }
+    }
+    SECTION("guided")
+    {
+        auto vector = std::vector<int>(10001, -1);
+        hipony::for_each(self_scheduling_policy{3}, enumerate(vector), assign_index{});
+        for (auto&& item : enumerate(vector)) {
+            REQUIRE(static_cast<int>(item.index) == item.value);
+        }
+    }
+    SECTION("limited")
+    {
+        int container[100] = {};
+        hipony::for_each(self_scheduling, enumerate(container, 50u), assign_index{});
+        REQUIRE(container[49] == 49);
+        REQUIRE(container[50] == 0);
+    }
+    SECTION("empty")
+    {
+        auto vector = std::vector<int>();
+        hipony::for_each(self_scheduling, enumerate(vector), assign_index{});
+        REQUIRE(vector.empty());
+    }
+    SECTION("exception")
+    {
+        auto vector = std::vector<int>(1000);
+        REQUIRE_THROWS_AS(
+            hipony::for_each(self_scheduling_policy{4, 8}, enumerate(vector), throw_at_500{}),
+            std::runtime_error);
+    }
+}
+
+TEST_CASE("read_ahead")
+{
+    SECTION("input")
+    {
+        auto counter    = 0;
+        auto mismatches = 0;
+        auto range      = enumerate(
+            read_ahead_policy{16}, counting_iterator{0}, counting_iterator{10000});
+        for (auto&& item : range) {
+            assert_same<int&, decltype(item.value)>();
+            assert_same<std::size_t, decltype(item.index)>();
+
+            mismatches += static_cast<int>(item.index) != item.value ? 1 : 0;
+            ++counter;
+        }
+        REQUIRE(mismatches == 0);
+        REQUIRE(counter == 10000);
+    }
+    SECTION("list")
+    {
+        auto list = std::list<int>({0, 10, 20, 30, 40});
+        auto sum  = 0;
+        for (auto&& item : enumerate_as<int>(read_ahead, list.begin(), list.end())) {
+            assert_same<int, decltype(item.index)>();
+            REQUIRE(item.index * 10 == item.value);
+            sum += item.value;
+        }
+        REQUIRE(sum == 100);
+    }
+    SECTION("break")
+    {
+        for (auto&& item :
+             enumerate(read_ahead_policy{4}, counting_iterator{0}, counting_iterator{1000})) {
+            if (item.index == 10) {
+                break;
+            }
+        }
+    }
+    SECTION("empty")
+    {
+        auto const range = enumerate(read_ahead, counting_iterator{0}, counting_iterator{0});
+        REQUIRE(range.begin() == range.end());
+    }
+    SECTION("exception")
+    {
+        auto counter = 0;
+        auto const iterate = [&] {
+            for (auto&& item : enumerate(
+                     read_ahead_policy{8}, counting_iterator{0, 500}, counting_iterator{1000})) {
+                static_cast<void>(item);
+                ++counter;
+            }
+        };
+        REQUIRE_THROWS_AS(iterate(), std::runtime_error);
+        REQUIRE(counter == 500);
+    }
+}
+
+#endif
+
+#if HIPONY_ENUMERATE_HAS_CONSTEXPR
+
+TEST_CASE("constexpr")
+{
+    struct function_object {
+        constexpr auto operator()() const -> int
+        {
+            for (auto item : enumerate(as_array, 0, 10, 20, 30, 40)) {
+                if (item.index == 3) {
+                    return item.value;
+                }
+            }
+            return 0;
+        }
+    };
+    constexpr auto const value = function_object{}();
+    REQUIRE(value == 30);
+}
+
+#endif
+
+#if HIPONY_ENUMERATE_HAS_AGGREGATES
+
+TEST_CASE("aggregate_tag_t")
+{
+    struct aggregate_t {
+        int         i;
+        double      d;
+        char const* str;
+    };
+    SECTION("prvalue")
+    {
+        auto counter = 0;
+        enumerate(aggregate_t{0, 1., "str"}).each([&](auto index, auto& value) {
+            REQUIRE(index == index_of<typename std::decay<decltype(value)>::type>());
+            ++counter;
+        });
+        REQUIRE(counter == 3);
+    }
+    SECTION("lvalue")
+    {
+        auto counter   = 0;
+        auto aggregate = aggregate_t{0, 1., "str"};
+        enumerate(aggregate).each([&](auto index, auto& value) {
+            assert_same<decltype(index), std::size_t>();
+
+            REQUIRE(index == index_of<typename std::decay<decltype(value)>::type>());
+            ++counter;
+        });
+        REQUIRE(counter == 3);
+    }
+    SECTION("const")
+    {
+        auto       counter   = 0;
+        auto const aggregate = aggregate_t{0, 1., "str"};
+        enumerate(aggregate).each([&](auto index, auto& value) {
+            assert_same<decltype(index), std::size_t>();
+            static_assert(
+                std::is_const<typename std::remove_reference<decltype(value)>::type>::value,
                 "Const propagation is broken");
 
             REQUIRE(index == index_of<typename std::decay<decltype(value)>::type>());
@@ -1979,6 +3677,26 @@ TEST_CASE("aggregate_tag_t")
         });
         REQUIRE(counter == 3);
     }
+    SECTION("each_until")
+    {
+        auto       counter   = 0;
+        auto const aggregate = aggregate_t{0, 1., "str"};
+        auto const found     = enumerate(aggregate).each_until([&](auto index, auto& /*value*/) {
+            ++counter;
+            return index == 1;
+        });
+        REQUIRE(found);
+        REQUIRE(counter == 2);
+    }
+    SECTION("visit_at")
+    {
+        auto aggregate = aggregate_t{0, 1., "str"};
+        enumerate(aggregate).visit_at(1, [](auto index, auto& value) {
+            REQUIRE(index == 1);
+            value = {};
+        });
+        REQUIRE(aggregate.d == 0.);
+    }
 }
 
 #endif
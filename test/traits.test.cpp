@@ -251,8 +251,8 @@ static_assert(detail::is_range<decltype(enumerate(as_array, 0, 1, 2, 3, 4))>::va
 static_assert(detail::is_range<decltype(enumerate_as<int>(as_array, 0, 1, 2, 3, 4))>::value, "");
 
 // variadic_tuple_tag_t
-static_assert(!detail::is_range<decltype(enumerate(as_tuple, 0, 1, 2, 3, 4))>::value, "");
-static_assert(!detail::is_range<decltype(enumerate_as<int>(as_tuple, 0, 1, 2, 3, 4))>::value, "");
+static_assert(detail::is_range<decltype(enumerate(as_tuple, 0, 1, 2, 3, 4))>::value, "");
+static_assert(detail::is_range<decltype(enumerate_as<int>(as_tuple, 0, 1, 2, 3, 4))>::value, "");
 static_assert(!detail::is_range<decltype(enumerate(as_tuple, 0, 1., "string"))>::value, "");
 static_assert(!detail::is_range<decltype(enumerate_as<int>(as_tuple, 0, 1., "string"))>::value, "");
 